@@ -0,0 +1,240 @@
+#include "acoustic_material.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace AnantaSound {
+
+namespace {
+
+// Sabine constant 24 ln(10) / c for c = 343 m/s
+constexpr double kSabineConstant = 0.161;
+
+// Keeps reverberation times finite for fully reflective or fully absorbing bands
+constexpr double kMinAbsorption = 1e-4;
+constexpr double kMaxEyringAbsorption = 0.9999;
+
+// Frequencies below this are clamped before taking the logarithm
+constexpr double kMinFrequency = 1e-3;
+
+// Relative tolerance when checking a table for constant log spacing
+constexpr double kUniformSpacingTolerance = 1e-9;
+
+constexpr double kOctaveReference = 1000.0;
+
+std::vector<double> makeBands(int first, int last, int bands_per_octave) {
+    std::vector<double> bands;
+    for (int k = first; k <= last; ++k) {
+        bands.push_back(kOctaveReference * std::exp2(static_cast<double>(k) / bands_per_octave));
+    }
+    return bands;
+}
+
+// log2 for positive normal x via exponent extraction and the atanh series of
+// the mantissa folded into [sqrt(1/2), sqrt(2)); error below 1e-9, branch-free
+// so batch loops vectorize
+inline double fastLog2(double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    double exponent = static_cast<double>(static_cast<int64_t>((bits >> 52) & 0x7ff) - 1023);
+    bits = (bits & 0x000fffffffffffffULL) | 0x3ff0000000000000ULL;
+    double mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(mantissa));
+    const bool fold = mantissa > M_SQRT2;
+    mantissa = fold ? 0.5 * mantissa : mantissa;
+    exponent = fold ? exponent + 1.0 : exponent;
+
+    const double s = (mantissa - 1.0) / (mantissa + 1.0);
+    const double z = s * s;
+    const double log_mantissa = s * (2.0 + z * (2.0 / 3.0 + z * (0.4 + z * (2.0 / 7.0 + z * (2.0 / 9.0)))));
+    return exponent + log_mantissa * M_LOG2E;
+}
+
+inline double reverbTimeFor(double volume, double surface_area, double absorption, ReverbFormula formula) {
+    if (formula == ReverbFormula::EYRING) {
+        return eyringReverbTime(volume, surface_area, absorption);
+    }
+    return sabineReverbTime(volume, surface_area, absorption);
+}
+
+} // namespace
+
+const std::vector<double>& octaveBandFrequencies() {
+    static const std::vector<double> bands = makeBands(-5, 4, 1);
+    return bands;
+}
+
+const std::vector<double>& thirdOctaveBandFrequencies() {
+    static const std::vector<double> bands = makeBands(-16, 13, 3);
+    return bands;
+}
+
+double interpolateLogFrequency(const double* frequencies, const double* values, size_t count,
+                               double frequency) {
+    if (count == 0) {
+        return 0.0;
+    }
+    if (!(frequency > frequencies[0])) {
+        return values[0]; // also NaN
+    }
+    if (frequency >= frequencies[count - 1]) {
+        return values[count - 1];
+    }
+    const size_t upper = std::upper_bound(frequencies, frequencies + count, frequency) - frequencies;
+    const size_t lower = upper - 1;
+    const double t = std::log2(frequency / frequencies[lower]) / std::log2(frequencies[upper] / frequencies[lower]);
+    return values[lower] + t * (values[upper] - values[lower]);
+}
+
+double sabineReverbTime(double volume, double surface_area, double absorption) {
+    const double alpha = std::max(absorption, kMinAbsorption);
+    return kSabineConstant * volume / (surface_area * alpha);
+}
+
+double eyringReverbTime(double volume, double surface_area, double absorption) {
+    const double alpha = std::min(std::max(absorption, kMinAbsorption), kMaxEyringAbsorption);
+    return kSabineConstant * volume / (-surface_area * std::log1p(-alpha));
+}
+
+AcousticMaterial::AcousticMaterial()
+    : AcousticMaterial(preset(MaterialPreset::STANDARD)) {
+}
+
+AcousticMaterial::AcousticMaterial(const std::string& name, const std::vector<double>& frequencies,
+                                   const std::vector<double>& absorption,
+                                   double reflection, double diffusion)
+    : name_(name)
+    , reflection_(reflection)
+    , diffusion_(diffusion)
+    , bands_per_octave_(0.0) {
+
+    const size_t count = std::min(frequencies.size(), absorption.size());
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), size_t(0));
+    std::sort(order.begin(), order.end(),
+              [&frequencies](size_t a, size_t b) { return frequencies[a] < frequencies[b]; });
+
+    for (size_t index : order) {
+        if (frequencies[index] <= 0.0 ||
+            (!frequencies_.empty() && frequencies[index] == frequencies_.back())) {
+            continue;
+        }
+        frequencies_.push_back(frequencies[index]);
+        log_frequencies_.push_back(std::log2(frequencies[index]));
+        absorption_.push_back(std::min(std::max(absorption[index], 0.0), 1.0));
+    }
+
+    // Constant log spacing enables direct band lookup
+    if (log_frequencies_.size() >= 2) {
+        const double step = log_frequencies_[1] - log_frequencies_[0];
+        bool uniform = true;
+        for (size_t i = 2; i < log_frequencies_.size() && uniform; ++i) {
+            uniform = std::abs(log_frequencies_[i] - log_frequencies_[i - 1] - step) <=
+                      kUniformSpacingTolerance * std::max(1.0, step);
+        }
+        if (uniform) {
+            bands_per_octave_ = 1.0 / step;
+        }
+    }
+}
+
+AcousticMaterial AcousticMaterial::flat(const std::string& name, double absorption,
+                                        double reflection, double diffusion) {
+    const auto& bands = octaveBandFrequencies();
+    return AcousticMaterial(name, bands, std::vector<double>(bands.size(), absorption), reflection, diffusion);
+}
+
+AcousticMaterial AcousticMaterial::preset(MaterialPreset preset) {
+    switch (preset) {
+        case MaterialPreset::ACOUSTIC:
+            return flat("Acoustic", 0.3, 0.2, 0.7);
+        case MaterialPreset::REFLECTIVE:
+            return flat("Reflective", 0.05, 0.6, 0.3);
+        case MaterialPreset::ABSORBENT:
+            return flat("Absorbent", 0.5, 0.1, 0.8);
+        case MaterialPreset::STANDARD:
+        default:
+            return flat("Standard", 0.1, 0.3, 0.5);
+    }
+}
+
+double AcousticMaterial::absorptionAt(double frequency) const {
+    return interpolateLogFrequency(frequencies_.data(), absorption_.data(), frequencies_.size(), frequency);
+}
+
+void AcousticMaterial::absorptionAt(const double* frequencies, double* absorption, size_t count) const {
+    const size_t bands = absorption_.size();
+    if (bands == 0) {
+        std::fill(absorption, absorption + count, 0.0);
+        return;
+    }
+    if (bands == 1) {
+        std::fill(absorption, absorption + count, absorption_[0]);
+        return;
+    }
+
+    const double* table = absorption_.data();
+    if (bands_per_octave_ > 0.0) {
+        // Uniform grid: fractional band position straight from log2(f)
+        const double origin = log_frequencies_[0];
+        const double scale = bands_per_octave_;
+        const double last = static_cast<double>(bands - 1);
+        for (size_t i = 0; i < count; ++i) {
+            // NaN and non-positive frequencies map to the lowest band: fastLog2
+            // needs a positive input and a NaN position would reach the cast
+            const double frequency = frequencies[i] > kMinFrequency ? frequencies[i] : kMinFrequency;
+            double position = (fastLog2(frequency) - origin) * scale;
+            position = std::min(std::max(position, 0.0), last);
+            const size_t lower = std::min(static_cast<size_t>(position), bands - 2);
+            const double t = position - static_cast<double>(lower);
+            absorption[i] = table[lower] + t * (table[lower + 1] - table[lower]);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        absorption[i] = interpolateLogFrequency(frequencies_.data(), table, bands, frequencies[i]);
+    }
+}
+
+std::vector<double> AcousticMaterial::absorptionAt(const std::vector<double>& frequencies) const {
+    std::vector<double> absorption(frequencies.size());
+    absorptionAt(frequencies.data(), absorption.data(), frequencies.size());
+    return absorption;
+}
+
+AcousticMaterial AcousticMaterial::resampled(const std::vector<double>& band_frequencies) const {
+    return AcousticMaterial(name_, band_frequencies, absorptionAt(band_frequencies), reflection_, diffusion_);
+}
+
+double AcousticMaterial::reverbTime(double frequency, double volume, double surface_area,
+                                    ReverbFormula formula) const {
+    return reverbTimeFor(volume, surface_area, absorptionAt(frequency), formula);
+}
+
+void AcousticMaterial::reverbTimes(const double* frequencies, double* reverb_times, size_t count,
+                                   double volume, double surface_area, ReverbFormula formula) const {
+    absorptionAt(frequencies, reverb_times, count);
+    if (formula == ReverbFormula::EYRING) {
+        for (size_t i = 0; i < count; ++i) {
+            reverb_times[i] = eyringReverbTime(volume, surface_area, reverb_times[i]);
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            reverb_times[i] = sabineReverbTime(volume, surface_area, reverb_times[i]);
+        }
+    }
+}
+
+std::vector<double> AcousticMaterial::bandReverbTimes(double volume, double surface_area,
+                                                      ReverbFormula formula) const {
+    std::vector<double> reverb_times(absorption_.size());
+    for (size_t i = 0; i < absorption_.size(); ++i) {
+        reverb_times[i] = reverbTimeFor(volume, surface_area, absorption_[i], formula);
+    }
+    return reverb_times;
+}
+
+} // namespace AnantaSound
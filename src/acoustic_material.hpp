@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Материалы купола из спецификации DAGA (docs/formats/DAGA_FORMAT.md)
+enum class MaterialPreset {
+    STANDARD,       // Поглощение 0.1, отражение 0.3, диффузия 0.5
+    ACOUSTIC,       // Поглощение 0.3, отражение 0.2, диффузия 0.7
+    REFLECTIVE,     // Поглощение 0.05, отражение 0.6, диффузия 0.3
+    ABSORBENT       // Поглощение 0.5, отражение 0.1, диффузия 0.8
+};
+
+// Формула времени реверберации
+enum class ReverbFormula {
+    SABINE,         // T = 0.161 V / (S α)
+    EYRING          // T = 0.161 V / (-S ln(1 - α)), точнее при большом α
+};
+
+// Центральные частоты октавных (31.25 Гц - 16 кГц) и третьоктавных
+// (25 Гц - 20 кГц) полос: 1000 * 2^(k/N), точные значения вместо номинальных
+const std::vector<double>& octaveBandFrequencies();
+const std::vector<double>& thirdOctaveBandFrequencies();
+
+// Линейная интерполяция по log2(f) в таблице с возрастающими частотами;
+// за пределами таблицы - крайние значения
+double interpolateLogFrequency(const double* frequencies, const double* values, size_t count,
+                               double frequency);
+
+// Время реверберации по среднему коэффициенту поглощения
+double sabineReverbTime(double volume, double surface_area, double absorption);
+double eyringReverbTime(double volume, double surface_area, double absorption);
+
+// Частотно-зависимый материал: таблица коэффициентов поглощения по полосам.
+// Таблицы с постоянным шагом по логарифму частоты (октавы, трети октав)
+// интерполируются без поиска: номер полосы вычисляется из log2(f).
+class AcousticMaterial {
+private:
+    std::string name_;
+    std::vector<double> frequencies_;       // Центральные частоты полос, по возрастанию
+    std::vector<double> log_frequencies_;   // log2 частот
+    std::vector<double> absorption_;        // Коэффициент поглощения полосы, [0, 1]
+    double reflection_;
+    double diffusion_;
+    double bands_per_octave_;               // > 0, если шаг по log2(f) постоянный
+
+public:
+    // Стандартный материал DAGA
+    AcousticMaterial();
+
+    // Таблица поглощения; частоты сортируются, поглощение ограничивается [0, 1]
+    AcousticMaterial(const std::string& name, const std::vector<double>& frequencies,
+                     const std::vector<double>& absorption,
+                     double reflection = 0.0, double diffusion = 0.0);
+
+    // Постоянное поглощение на октавной сетке
+    static AcousticMaterial flat(const std::string& name, double absorption,
+                                 double reflection = 0.0, double diffusion = 0.0);
+
+    // Пресет DAGA (спецификация задает широкополосные значения)
+    static AcousticMaterial preset(MaterialPreset preset);
+
+    const std::string& getName() const { return name_; }
+    const std::vector<double>& getBandFrequencies() const { return frequencies_; }
+    const std::vector<double>& getBandAbsorption() const { return absorption_; }
+    double getReflection() const { return reflection_; }
+    double getDiffusion() const { return diffusion_; }
+
+    // Поглощение на произвольной частоте
+    double absorptionAt(double frequency) const;
+
+    // Пакетное вычисление поглощения
+    void absorptionAt(const double* frequencies, double* absorption, size_t count) const;
+    std::vector<double> absorptionAt(const std::vector<double>& frequencies) const;
+
+    // Пересчет таблицы на другую сетку полос
+    AcousticMaterial resampled(const std::vector<double>& band_frequencies) const;
+
+    // Время реверберации помещения из этого материала
+    double reverbTime(double frequency, double volume, double surface_area,
+                      ReverbFormula formula = ReverbFormula::SABINE) const;
+    void reverbTimes(const double* frequencies, double* reverb_times, size_t count,
+                     double volume, double surface_area,
+                     ReverbFormula formula = ReverbFormula::SABINE) const;
+
+    // Время реверберации в полосах таблицы
+    std::vector<double> bandReverbTimes(double volume, double surface_area,
+                                        ReverbFormula formula = ReverbFormula::SABINE) const;
+};
+
+} // namespace AnantaSound
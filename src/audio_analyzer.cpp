@@ -1,4 +1,5 @@
 #include "audio_analyzer.hpp"
+#include "fast_math.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -273,7 +274,7 @@ std::vector<double> AudioAnalyzer::phaseSpectrum(const std::vector<std::complex<
     std::vector<double> phase(fft_result.size() / 2 + 1);
     
     for (size_t i = 0; i < phase.size(); ++i) {
-        phase[i] = std::arg(fft_result[i]);
+        phase[i] = fastArg(fft_result[i]);
     }
     
     return phase;
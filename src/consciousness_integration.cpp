@@ -9,7 +9,8 @@ ConsciousnessIntegration::ConsciousnessIntegration()
     : coherence_threshold_(0.7)
     , integration_depth_(5)
     , consciousness_state_(ConsciousnessState::AWARE)
-    , last_update_(std::chrono::high_resolution_clock::now()) {
+    , last_update_(std::chrono::high_resolution_clock::now())
+    , math_accuracy_(getDefaultMathAccuracy()) {
     
     // Initialize consciousness field
     consciousness_field_.amplitude = std::complex<double>(1.0, 0.0);
@@ -54,11 +55,15 @@ double ConsciousnessIntegration::calculateConsciousnessCoherence(const std::vect
         phases.push_back(field.phase);
     }
     
+    std::vector<double> sines(phases.size());
+    std::vector<double> cosines(phases.size());
+    fastSinCosBatch(phases.data(), sines.data(), cosines.data(), phases.size(), math_accuracy_);
+    
     // Calculate circular variance (measure of phase coherence)
     double mean_sin = 0.0, mean_cos = 0.0;
-    for (double phase : phases) {
-        mean_sin += std::sin(phase);
-        mean_cos += std::cos(phase);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        mean_sin += sines[i];
+        mean_cos += cosines[i];
     }
     mean_sin /= phases.size();
     mean_cos /= phases.size();
@@ -125,6 +130,10 @@ void ConsciousnessIntegration::setIntegrationDepth(int depth) {
     integration_depth_ = std::max(1, depth);
 }
 
+void ConsciousnessIntegration::setMathAccuracy(MathAccuracy accuracy) {
+    math_accuracy_ = accuracy;
+}
+
 std::vector<double> ConsciousnessIntegration::getConsciousnessSpectrum() const {
     std::vector<double> spectrum;
     spectrum.reserve(integration_depth_);
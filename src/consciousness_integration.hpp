@@ -1,6 +1,7 @@
 #pragma once
 
 #include "anantasound_core.hpp"
+#include "fast_math.hpp"
 #include <vector>
 #include <memory>
 
@@ -21,6 +22,7 @@ private:
     ConsciousnessState consciousness_state_;
     QuantumSoundField consciousness_field_;
     std::chrono::high_resolution_clock::time_point last_update_;
+    MathAccuracy math_accuracy_;
 
 public:
     ConsciousnessIntegration();
@@ -40,6 +42,7 @@ public:
     // Configuration
     void setCoherenceThreshold(double threshold);
     void setIntegrationDepth(int depth);
+    void setMathAccuracy(MathAccuracy accuracy);
     
     // Analysis
     std::vector<double> getConsciousnessSpectrum() const;
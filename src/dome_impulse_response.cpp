@@ -0,0 +1,563 @@
+#include "dome_impulse_response.hpp"
+#include "dome_reflections.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace AnantaSound {
+
+namespace {
+
+// Octave bands of the late tail
+constexpr double kLowestTailBand = 100.0;
+constexpr double kHighestTailBand = 10000.0;
+constexpr double kOctaveBandQ = M_SQRT2;
+
+// Linear fade-in of the tail at the early/late transition (s)
+constexpr double kTailFadeTime = 0.01;
+
+// Source-receiver distance floor for the 1/r law (m)
+constexpr double kMinDistance = 0.1;
+
+// Points are kept this far inside the boundary (fraction of the radius)
+constexpr double kContainmentMargin = 1e-3;
+
+// Rays below this fraction of their initial energy are dropped
+constexpr double kMinRayEnergy = 1e-6;
+
+constexpr double kIntersectionEpsilon = 1e-9;
+
+// Absorption derived from RT60 is kept in this range
+constexpr double kMinBandAbsorption = 1e-3;
+constexpr double kMaxBandAbsorption = 0.99;
+
+// Disk cache layout: "ASIR", format version, key, sample rate, count, float samples
+constexpr char kCacheMagic[4] = {'A', 'S', 'I', 'R'};
+constexpr uint32_t kCacheFormatVersion = 2;
+
+// FNV-1a over the raw bytes of the key inputs
+class KeyHasher {
+private:
+    uint64_t hash_ = 0xcbf29ce484222325ULL;
+
+public:
+    void add(const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= 0x100000001b3ULL;
+        }
+    }
+
+    template <typename T>
+    void add(const T& value) {
+        add(&value, sizeof(value));
+    }
+
+    uint64_t value() const { return hash_; }
+};
+
+inline double dot(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Adds value at fractional sample position by linear split
+inline void depositLinear(std::vector<double>& buffer, double position, double value) {
+    if (position < 0.0) {
+        return;
+    }
+    const size_t index = static_cast<size_t>(position);
+    if (index + 1 >= buffer.size()) {
+        return;
+    }
+    const double t = position - static_cast<double>(index);
+    buffer[index] += (1.0 - t) * value;
+    buffer[index + 1] += t * value;
+}
+
+inline double absorptionFromReverbTime(double volume, double surface_area, double reverb_time) {
+    const double alpha = 0.161 * volume / (surface_area * std::max(reverb_time, 1e-3));
+    return std::min(std::max(alpha, kMinBandAbsorption), kMaxBandAbsorption);
+}
+
+} // namespace
+
+DomeImpulseResponseGenerator::DomeImpulseResponseGenerator(const DomeAcousticResonator& resonator,
+                                                           const ImpulseResponseSettings& settings)
+    : shape_(resonator.getShapeModel())
+    , radius_(resonator.getRadius())
+    , height_(resonator.getHeight())
+    , volume_(resonator.getVolume())
+    , surface_area_(resonator.getSurfaceArea())
+    , settings_(settings)
+    , cache_hits_(0)
+    , cache_misses_(0) {
+
+    for (double band : octaveBandFrequencies()) {
+        if (band >= kLowestTailBand && band <= kHighestTailBand && band < 0.45 * settings_.sample_rate) {
+            band_frequencies_.push_back(band);
+        }
+    }
+    band_reverb_times_ = resonator.calculateReverbTimes(band_frequencies_);
+
+    // Early reflections are broadband: mean of the band absorptions
+    double absorption = 0.0;
+    for (double reverb_time : band_reverb_times_) {
+        absorption += absorptionFromReverbTime(volume_, surface_area_, reverb_time);
+    }
+    early_absorption_ = band_reverb_times_.empty() ? kMinBandAbsorption
+                                                   : absorption / band_reverb_times_.size();
+    scattering_ = std::min(std::max(resonator.getMaterial().getDiffusion(), 0.0), 1.0);
+}
+
+ImpulseResponse DomeImpulseResponseGenerator::generate(const SphericalCoord& source,
+                                                       const SphericalCoord& receiver) const {
+    double s[3], r[3];
+    toContainedCartesian(source, s);
+    toContainedCartesian(receiver, r);
+    const uint64_t key = cacheKey(s, r);
+
+    ImpulseResponse response;
+    if (!settings_.cache_directory.empty()) {
+        if (loadCached(key, response)) {
+            ++cache_hits_;
+            return response;
+        }
+        ++cache_misses_;
+    }
+
+    response = render(s, r, key);
+    if (!settings_.cache_directory.empty()) {
+        storeCached(key, response);
+    }
+    return response;
+}
+
+std::vector<ImpulseResponse> DomeImpulseResponseGenerator::generate(const SphericalCoord& source,
+                                                                    const std::vector<SphericalCoord>& receivers) const {
+    std::vector<ImpulseResponse> responses(receivers.size());
+    ThreadPool::shared().parallelFor(receivers.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            responses[i] = generate(source, receivers[i]);
+        }
+    });
+    return responses;
+}
+
+uint64_t DomeImpulseResponseGenerator::cacheKey(const SphericalCoord& source, const SphericalCoord& receiver) const {
+    double s[3], r[3];
+    toContainedCartesian(source, s);
+    toContainedCartesian(receiver, r);
+    return cacheKey(s, r);
+}
+
+uint64_t DomeImpulseResponseGenerator::cacheKey(const double source[3], const double receiver[3]) const {
+    KeyHasher hasher;
+    hasher.add(kCacheFormatVersion);
+    hasher.add(static_cast<int>(shape_));
+    hasher.add(radius_);
+    hasher.add(height_);
+    hasher.add(volume_);
+    hasher.add(surface_area_);
+    hasher.add(early_absorption_);
+    hasher.add(scattering_);
+    hasher.add(band_frequencies_.data(), band_frequencies_.size() * sizeof(double));
+    hasher.add(band_reverb_times_.data(), band_reverb_times_.size() * sizeof(double));
+    hasher.add(settings_.sample_rate);
+    hasher.add(settings_.duration);
+    hasher.add(settings_.early_duration);
+    hasher.add(static_cast<uint64_t>(settings_.ray_count));
+    hasher.add(static_cast<uint64_t>(settings_.max_reflection_order));
+    hasher.add(settings_.receiver_radius);
+    hasher.add(settings_.speed_of_sound);
+    hasher.add(settings_.seed);
+    hasher.add(source, 3 * sizeof(double));
+    hasher.add(receiver, 3 * sizeof(double));
+    return hasher.value();
+}
+
+void DomeImpulseResponseGenerator::toContainedCartesian(const SphericalCoord& position, double point[3]) const {
+    point[0] = position.r * std::sin(position.theta) * std::cos(position.phi);
+    point[1] = position.r * std::sin(position.theta) * std::sin(position.phi);
+    point[2] = position.height;
+
+    const double margin = kContainmentMargin * radius_;
+    const double limit = radius_ - margin;
+    if (shape_ == DomeShapeModel::CYLINDER) {
+        const double horizontal = std::hypot(point[0], point[1]);
+        if (horizontal > limit) {
+            point[0] *= limit / horizontal;
+            point[1] *= limit / horizontal;
+        }
+        point[2] = std::min(std::max(point[2], margin), height_ - margin);
+        return;
+    }
+
+    if (shape_ == DomeShapeModel::HEMISPHERE) {
+        point[2] = std::max(point[2], margin);
+    }
+    const double distance = std::sqrt(dot(point, point));
+    if (distance > limit) {
+        for (int axis = 0; axis < 3; ++axis) {
+            point[axis] *= limit / distance;
+        }
+    }
+}
+
+ImpulseResponse DomeImpulseResponseGenerator::render(const double source[3], const double receiver[3],
+                                                     uint64_t key) const {
+    ImpulseResponse response;
+    response.sample_rate = settings_.sample_rate;
+    const size_t length = static_cast<size_t>(std::ceil(settings_.duration * settings_.sample_rate));
+    if (length == 0) {
+        return response;
+    }
+
+    std::vector<double> pressure(length, 0.0);
+    addImageSources(source, receiver, pressure);
+
+    // Ray energies arrive incoherently, so they are summed before the square root
+    const size_t early_length = std::min(length, static_cast<size_t>(
+        std::ceil(settings_.early_duration * settings_.sample_rate)) + 2);
+    std::vector<double> energy(early_length, 0.0);
+    RandomStream ray_random(settings_.seed, key);
+    traceRays(source, receiver, ray_random, energy);
+    for (size_t i = 0; i < early_length; ++i) {
+        pressure[i] += std::sqrt(energy[i]);
+    }
+
+    double delta[3] = {receiver[0] - source[0], receiver[1] - source[1], receiver[2] - source[2]};
+    const double direct_time = std::sqrt(dot(delta, delta)) / settings_.speed_of_sound;
+    RandomStream tail_random(settings_.seed, ~key);
+    addLateTail(std::max(settings_.early_duration, direct_time), tail_random, pressure);
+
+    response.samples.assign(pressure.begin(), pressure.end());
+    return response;
+}
+
+void DomeImpulseResponseGenerator::addImageSources(const double source[3], const double receiver[3],
+                                                   std::vector<double>& pressure) const {
+    const double max_distance = settings_.early_duration * settings_.speed_of_sound;
+    const double samples_per_meter = settings_.sample_rate / settings_.speed_of_sound;
+
+    // Specular energy kept per reflection; the scattered part is picked up
+    // by the ray tracer
+    const double reflection_amplitude = std::sqrt((1.0 - early_absorption_) * (1.0 - scattering_));
+
+    auto addImage = [&](double z, size_t order, bool limited) {
+        const double dx = receiver[0] - source[0];
+        const double dy = receiver[1] - source[1];
+        const double dz = receiver[2] - z;
+        const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (limited && distance > max_distance) {
+            return;
+        }
+        const double amplitude = std::pow(reflection_amplitude, static_cast<double>(order)) /
+                                 std::max(distance, kMinDistance);
+        depositLinear(pressure, distance * samples_per_meter, amplitude);
+    };
+
+    // Direct sound is always present, even when it arrives after early_duration
+    addImage(source[2], 0, false);
+
+    // First-order specular reflections from the curved shell, the same paths
+    // RoomResponseCache uses; the ray tracer skips them
+    if (settings_.max_reflection_order >= 1) {
+        std::vector<double> shell_lengths;
+        findShellReflections(shape_, radius_, source, receiver, shell_lengths);
+        for (double length : shell_lengths) {
+            if (length <= max_distance) {
+                depositLinear(pressure, length * samples_per_meter,
+                              reflection_amplitude / std::max(length, kMinDistance));
+            }
+        }
+    }
+
+    if (shape_ == DomeShapeModel::HEMISPHERE) {
+        if (settings_.max_reflection_order >= 1) {
+            addImage(-source[2], 1, true);
+        }
+    } else if (shape_ == DomeShapeModel::CYLINDER && height_ > 0.0) {
+        // Floor/ceiling mirror lattice: 2mH + z (order 2|m|) and 2mH - z (order |2m - 1|)
+        const long max_m = static_cast<long>(max_distance / (2.0 * height_)) + 1;
+        for (long m = -max_m; m <= max_m; ++m) {
+            const size_t even_order = static_cast<size_t>(2 * std::labs(m));
+            const size_t odd_order = static_cast<size_t>(std::labs(2 * m - 1));
+            if (m != 0 && even_order <= settings_.max_reflection_order) {
+                addImage(2.0 * m * height_ + source[2], even_order, true);
+            }
+            if (odd_order <= settings_.max_reflection_order) {
+                addImage(2.0 * m * height_ - source[2], odd_order, true);
+            }
+        }
+    }
+}
+
+bool DomeImpulseResponseGenerator::intersect(const double p[3], const double d[3],
+                                             double& distance, double normal[3], bool& curved) const {
+    distance = std::numeric_limits<double>::infinity();
+    auto consider = [&](double t, double nx, double ny, double nz, bool is_curved) {
+        if (t > kIntersectionEpsilon && t < distance) {
+            distance = t;
+            normal[0] = nx;
+            normal[1] = ny;
+            normal[2] = nz;
+            curved = is_curved;
+        }
+    };
+
+    if (shape_ == DomeShapeModel::SPHERE || shape_ == DomeShapeModel::HEMISPHERE) {
+        // Inside the sphere the far root is the exit point
+        const double b = dot(p, d);
+        const double c = dot(p, p) - radius_ * radius_;
+        const double discriminant = b * b - c;
+        if (discriminant >= 0.0) {
+            const double t = -b + std::sqrt(discriminant);
+            const double hx = p[0] + t * d[0];
+            const double hy = p[1] + t * d[1];
+            const double hz = p[2] + t * d[2];
+            consider(t, -hx / radius_, -hy / radius_, -hz / radius_, true);
+        }
+    }
+
+    if (shape_ != DomeShapeModel::SPHERE && d[2] < 0.0) {
+        consider(-p[2] / d[2], 0.0, 0.0, 1.0, false);
+    }
+
+    if (shape_ == DomeShapeModel::CYLINDER) {
+        if (d[2] > 0.0) {
+            consider((height_ - p[2]) / d[2], 0.0, 0.0, -1.0, false);
+        }
+        const double a = d[0] * d[0] + d[1] * d[1];
+        if (a > kIntersectionEpsilon) {
+            const double b = p[0] * d[0] + p[1] * d[1];
+            const double c = p[0] * p[0] + p[1] * p[1] - radius_ * radius_;
+            const double discriminant = b * b - a * c;
+            if (discriminant >= 0.0) {
+                const double t = (-b + std::sqrt(discriminant)) / a;
+                const double hx = p[0] + t * d[0];
+                const double hy = p[1] + t * d[1];
+                consider(t, -hx / radius_, -hy / radius_, 0.0, true);
+            }
+        }
+    }
+
+    return distance < std::numeric_limits<double>::infinity();
+}
+
+void DomeImpulseResponseGenerator::traceRays(const double source[3], const double receiver[3],
+                                             RandomStream& random, std::vector<double>& energy) const {
+    const size_t ray_count = settings_.ray_count;
+    if (ray_count == 0 || energy.empty()) {
+        return;
+    }
+
+    const double max_distance = settings_.early_duration * settings_.speed_of_sound;
+    const double samples_per_meter = settings_.sample_rate / settings_.speed_of_sound;
+    const double receiver_radius_sq = settings_.receiver_radius * settings_.receiver_radius;
+
+    // A ray carries 4π/N so that a specular path at distance D deposits 1/D^2,
+    // matching the squared 1/r pressure of the image sources
+    const double ray_energy = 4.0 * M_PI / static_cast<double>(ray_count);
+    const double hit_scale = 1.0 / (M_PI * receiver_radius_sq);
+    const double golden_angle = M_PI * (3.0 - std::sqrt(5.0));
+    const double retained = 1.0 - early_absorption_;
+
+    for (size_t ray = 0; ray < ray_count; ++ray) {
+        // Fibonacci sphere: evenly spread, deterministic directions
+        const double dz = 1.0 - 2.0 * (static_cast<double>(ray) + 0.5) / static_cast<double>(ray_count);
+        const double ring = std::sqrt(std::max(0.0, 1.0 - dz * dz));
+        double s, c;
+        fastSinCos(golden_angle * static_cast<double>(ray), s, c);
+        double d[3] = {ring * c, ring * s, dz};
+        double p[3] = {source[0], source[1], source[2]};
+
+        double weight = ray_energy;
+        double traveled = 0.0;
+        // Purely specular planar paths and single specular shell reflections
+        // are already covered by addImageSources
+        bool scattered = false;
+        bool curved_path = false;
+
+        for (size_t order = 0; order <= settings_.max_reflection_order; ++order) {
+            double t, n[3];
+            bool curved = false;
+            if (!intersect(p, d, t, n, curved)) {
+                break;
+            }
+
+            if (scattered || (curved_path && order >= 2)) {
+                const double segment = std::min(t, max_distance - traveled);
+                const double w[3] = {receiver[0] - p[0], receiver[1] - p[1], receiver[2] - p[2]};
+                const double u = std::min(std::max(dot(w, d), 0.0), segment);
+                const double ex = w[0] - u * d[0];
+                const double ey = w[1] - u * d[1];
+                const double ez = w[2] - u * d[2];
+                if (ex * ex + ey * ey + ez * ez <= receiver_radius_sq) {
+                    depositLinear(energy, (traveled + u) * samples_per_meter, weight * hit_scale);
+                }
+            }
+
+            traveled += t;
+            if (traveled >= max_distance || order == settings_.max_reflection_order) {
+                break;
+            }
+
+            for (int axis = 0; axis < 3; ++axis) {
+                p[axis] += t * d[axis];
+            }
+            weight *= retained;
+            if (weight < kMinRayEnergy * ray_energy) {
+                break;
+            }
+
+            if (random.nextUniform() < scattering_) {
+                // Lambert reflection about the inward normal
+                const double cos_theta = std::sqrt(random.nextUniform());
+                const double sin_theta = std::sqrt(1.0 - cos_theta * cos_theta);
+                double sp, cp;
+                fastSinCos(2.0 * M_PI * random.nextUniform(), sp, cp);
+                double tangent[3];
+                if (std::abs(n[0]) < 0.9) {
+                    tangent[0] = 0.0; tangent[1] = n[2]; tangent[2] = -n[1];
+                } else {
+                    tangent[0] = -n[2]; tangent[1] = 0.0; tangent[2] = n[0];
+                }
+                const double tangent_length = std::sqrt(dot(tangent, tangent));
+                for (double& component : tangent) {
+                    component /= tangent_length;
+                }
+                const double bitangent[3] = {n[1] * tangent[2] - n[2] * tangent[1],
+                                             n[2] * tangent[0] - n[0] * tangent[2],
+                                             n[0] * tangent[1] - n[1] * tangent[0]};
+                for (int axis = 0; axis < 3; ++axis) {
+                    d[axis] = cos_theta * n[axis] + sin_theta * (cp * tangent[axis] + sp * bitangent[axis]);
+                }
+                scattered = true;
+            } else {
+                const double projection = 2.0 * dot(d, n);
+                for (int axis = 0; axis < 3; ++axis) {
+                    d[axis] -= projection * n[axis];
+                }
+                curved_path = curved_path || curved;
+            }
+        }
+    }
+}
+
+void DomeImpulseResponseGenerator::addLateTail(double start_time, RandomStream& random,
+                                               std::vector<double>& pressure) const {
+    const size_t length = pressure.size();
+    const size_t start = static_cast<size_t>(start_time * settings_.sample_rate);
+    if (start >= length || band_frequencies_.empty()) {
+        return;
+    }
+    const double fade_samples = std::max(1.0, kTailFadeTime * settings_.sample_rate);
+
+    std::vector<double> noise(length);
+    for (size_t b = 0; b < band_frequencies_.size(); ++b) {
+        random.fillNormal(noise.data(), length);
+        BiquadCascade filter({BiquadCoefficients::bandpass(band_frequencies_[b], kOctaveBandQ,
+                                                           settings_.sample_rate)});
+        filter.process(noise.data(), length);
+
+        // Exponential envelope with the band's RT60: 60 dB over T
+        const double decay_rate = 3.0 * std::log(10.0) / std::max(band_reverb_times_[b], 1e-3);
+        const double step = std::exp(-decay_rate / settings_.sample_rate);
+        double envelope = 1.0;
+        double band_energy = 0.0;
+        for (size_t i = 0; i < length; ++i) {
+            noise[i] *= envelope;
+            band_energy += noise[i] * noise[i];
+            envelope *= step;
+        }
+        if (band_energy <= 0.0) {
+            continue;
+        }
+
+        // Diffuse-field energy relative to the 1/r direct sound, shared by the bands
+        const double alpha = absorptionFromReverbTime(volume_, surface_area_, band_reverb_times_[b]);
+        const double target = 16.0 * M_PI * (1.0 - alpha) / (surface_area_ * alpha) /
+                              static_cast<double>(band_frequencies_.size());
+        const double scale = std::sqrt(target / band_energy);
+
+        for (size_t i = start; i < length; ++i) {
+            const double fade = std::min(1.0, static_cast<double>(i - start + 1) / fade_samples);
+            pressure[i] += scale * fade * noise[i];
+        }
+    }
+}
+
+std::string DomeImpulseResponseGenerator::cachePath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "ir_%016llx.bin", static_cast<unsigned long long>(key));
+    std::string path = settings_.cache_directory;
+    if (!path.empty() && path.back() != '/') {
+        path += '/';
+    }
+    return path + name;
+}
+
+bool DomeImpulseResponseGenerator::loadCached(uint64_t key, ImpulseResponse& response) const {
+    std::ifstream file(cachePath(key), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint64_t stored_key = 0;
+    double sample_rate = 0.0;
+    uint64_t count = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&stored_key), sizeof(stored_key));
+    file.read(reinterpret_cast<char*>(&sample_rate), sizeof(sample_rate));
+    file.read(reinterpret_cast<char*>(&count), sizeof(count));
+    if (!file || std::memcmp(magic, kCacheMagic, sizeof(magic)) != 0 ||
+        version != kCacheFormatVersion || stored_key != key ||
+        count != static_cast<uint64_t>(std::ceil(settings_.duration * settings_.sample_rate))) {
+        return false;
+    }
+
+    response.sample_rate = sample_rate;
+    response.samples.resize(count);
+    file.read(reinterpret_cast<char*>(response.samples.data()), count * sizeof(float));
+    return static_cast<bool>(file);
+}
+
+void DomeImpulseResponseGenerator::storeCached(uint64_t key, const ImpulseResponse& response) const {
+    // Written under a per-thread name and renamed, so readers never see a partial file
+    const std::string path = cachePath(key);
+    const std::string temporary = path + ".tmp" +
+                                  std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return;
+        }
+        const uint64_t count = response.samples.size();
+        file.write(kCacheMagic, sizeof(kCacheMagic));
+        file.write(reinterpret_cast<const char*>(&kCacheFormatVersion), sizeof(kCacheFormatVersion));
+        file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        file.write(reinterpret_cast<const char*>(&response.sample_rate), sizeof(response.sample_rate));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(response.samples.data()), count * sizeof(float));
+        if (!file) {
+            file.close();
+            std::remove(temporary.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "room_eq.hpp"
+#include <vector>
+#include <string>
+#include <atomic>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Параметры генерации импульсных откликов купола
+struct ImpulseResponseSettings {
+    double sample_rate = 48000.0;
+    double duration = 2.0;              // Длина отклика (с)
+    double early_duration = 0.08;       // Ранние отражения считаются геометрически (с)
+    size_t ray_count = 8192;            // Лучей на пару источник-приемник
+    size_t max_reflection_order = 64;
+    double receiver_radius = 0.25;      // Радиус сферы приемника (м)
+    double speed_of_sound = 343.0;
+    uint64_t seed = 0x5eedULL;
+    std::string cache_directory;        // Существующий каталог дискового кэша; пусто - без кэша
+};
+
+// Импульсный отклик (давление относительно прямого звука на расстоянии 1 м)
+struct ImpulseResponse {
+    double sample_rate = 0.0;
+    std::vector<float> samples;
+};
+
+// Генератор импульсных откликов для сферы, полусферы и цилиндра.
+// Прямой звук, отражения от плоскостей (пол, потолок цилиндра) и зеркальные
+// отражения первого порядка от кривой оболочки (findShellReflections, как в
+// RoomResponseCache) - точные мнимые источники. Остальные пути с отражением
+// от оболочки ищутся трассировкой лучей от источника со сферой приемника и
+// рассеянием по диффузии материала.
+// После early_duration - стохастический хвост: шум в октавных полосах с
+// затуханием по T60 резонатора и энергией диффузного поля 16π(1 - α)/(Sα).
+// Приемники обрабатываются параллельно; отклики детерминированы и при
+// заданном cache_directory сохраняются на диск с ключом - хэшем геометрии,
+// материала, параметров и позиций.
+class DomeImpulseResponseGenerator {
+private:
+    DomeShapeModel shape_;
+    double radius_;
+    double height_;
+    double volume_;
+    double surface_area_;
+    double early_absorption_;               // Поглощение для ранних отражений
+    double scattering_;                     // Доля диффузного отражения
+    std::vector<double> band_frequencies_;  // Октавные полосы хвоста
+    std::vector<double> band_reverb_times_;
+    ImpulseResponseSettings settings_;
+
+    mutable std::atomic<size_t> cache_hits_;
+    mutable std::atomic<size_t> cache_misses_;
+
+public:
+    // Геометрия, материал и времена реверберации берутся из резонатора
+    explicit DomeImpulseResponseGenerator(const DomeAcousticResonator& resonator,
+                                          const ImpulseResponseSettings& settings = ImpulseResponseSettings());
+
+    // Отклик для одной пары источник-приемник
+    ImpulseResponse generate(const SphericalCoord& source, const SphericalCoord& receiver) const;
+
+    // Отклики для набора приемников (параллельно)
+    std::vector<ImpulseResponse> generate(const SphericalCoord& source,
+                                          const std::vector<SphericalCoord>& receivers) const;
+
+    // Ключ дискового кэша для пары и путь к файлу отклика
+    uint64_t cacheKey(const SphericalCoord& source, const SphericalCoord& receiver) const;
+    std::string cachePath(uint64_t key) const;
+
+    const ImpulseResponseSettings& getSettings() const { return settings_; }
+    size_t getCacheHits() const { return cache_hits_.load(); }
+    size_t getCacheMisses() const { return cache_misses_.load(); }
+
+private:
+    // Перевод в декартовы координаты с переносом точки внутрь объема
+    void toContainedCartesian(const SphericalCoord& position, double point[3]) const;
+    uint64_t cacheKey(const double source[3], const double receiver[3]) const;
+
+    ImpulseResponse render(const double source[3], const double receiver[3], uint64_t key) const;
+    void addImageSources(const double source[3], const double receiver[3], std::vector<double>& pressure) const;
+    void traceRays(const double source[3], const double receiver[3], RandomStream& random,
+                   std::vector<double>& energy) const;
+    void addLateTail(double start_time, RandomStream& random, std::vector<double>& pressure) const;
+
+    // Ближайшее пересечение луча с границей: расстояние, нормаль внутрь,
+    // признак кривой поверхности
+    bool intersect(const double position[3], const double direction[3],
+                   double& distance, double normal[3], bool& curved) const;
+
+    bool loadCached(uint64_t key, ImpulseResponse& response) const;
+    void storeCached(uint64_t key, const ImpulseResponse& response) const;
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,343 @@
+#include "dome_modal_solver.hpp"
+#include "fast_math.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace AnantaSound {
+
+namespace {
+
+// Scan step for sign changes; consecutive zeros of J'_n and j'_l are more than
+// pi apart, so a step of 1 never brackets two of them
+constexpr double kZeroScanStep = 1.0;
+
+constexpr int kMaxNewtonIterations = 60;
+constexpr double kZeroTolerance = 1e-13;
+
+// Extra quadrature nodes beyond n + x. The aliasing error behaves like
+// J_{x+margin}(x), whose turning-point region is ~x^(1/3) orders wide, so the
+// margin grows with cbrt(x) to keep the error near rounding level
+constexpr int kQuadratureMargin = 24;
+constexpr double kQuadratureMarginPerCbrt = 12.0;
+
+// Extra orders above max(l, x) where the downward recurrence starts (plus sqrt(x))
+constexpr int kRecurrenceMargin = 32;
+
+constexpr double kRecurrenceRescale = 1e200;
+
+constexpr size_t kMaxCachedGeometries = 16;
+
+// J_n(x) and J_n'(x) from the Bessel integrals
+//   J_n(x)  = 1/pi * int_0^pi cos(n t - x sin t) dt
+//   J_n'(x) = 1/pi * int_0^pi sin(n t - x sin t) sin t dt
+// The integrands are smooth and periodic, so the trapezoidal rule converges
+// exponentially once the node count exceeds the order plus the argument.
+void besselJWithDerivative(int n, double x, double& value, double& derivative) {
+    const int margin = kQuadratureMargin + static_cast<int>(kQuadratureMarginPerCbrt * std::cbrt(std::abs(x)));
+    const int intervals = (n + static_cast<int>(std::abs(x)) + margin) / 2 + 1;
+    const double h = M_PI / intervals;
+    double sum = 0.0;
+    double derivative_sum = 0.0;
+    for (int k = 0; k <= intervals; ++k) {
+        const double t = k * h;
+        double sin_t, cos_t;
+        fastSinCos(t, sin_t, cos_t, MathAccuracy::HIGH);
+        double s, c;
+        fastSinCos(n * t - x * sin_t, s, c, MathAccuracy::HIGH);
+        const double weight = (k == 0 || k == intervals) ? 0.5 : 1.0;
+        sum += weight * c;
+        derivative_sum += weight * s * sin_t;
+    }
+    value = sum / intervals;
+    derivative = derivative_sum / intervals;
+}
+
+// j_l(x) and j_l(x)' by Miller's downward recurrence
+//   j_{k-1} = (2k + 1) / x * j_k - j_{k+1}
+// normalized against the closed forms of j_0 and j_1
+void sphericalBesselWithDerivative(int l, double x, double& value, double& derivative) {
+    if (x < 1e-8) {
+        value = (l == 0) ? 1.0 : 0.0;
+        derivative = (l == 1) ? 1.0 / 3.0 : 0.0;
+        return;
+    }
+
+    const int start = std::max(l, static_cast<int>(x)) + kRecurrenceMargin + static_cast<int>(std::sqrt(x));
+    double next = 0.0;          // j_{k+1}
+    double current = 1e-30;     // j_k
+    double j_l = 0.0;
+    double j_l_minus_1 = 0.0;
+    for (int k = start; k > 0; --k) {
+        const double previous = (2.0 * k + 1.0) / x * current - next;
+        next = current;
+        current = previous;
+        if (k - 1 == l) {
+            j_l = current;
+        } else if (k - 1 == l - 1) {
+            j_l_minus_1 = current;
+        }
+        if (std::abs(current) > kRecurrenceRescale) {
+            current /= kRecurrenceRescale;
+            next /= kRecurrenceRescale;
+            j_l /= kRecurrenceRescale;
+            j_l_minus_1 /= kRecurrenceRescale;
+        }
+    }
+
+    // Normalize with whichever of j_0, j_1 is farther from a zero
+    double s, c;
+    fastSinCos(x, s, c, MathAccuracy::HIGH);
+    const double exact_j0 = s / x;
+    const double exact_j1 = s / (x * x) - c / x;
+    const double scale = std::abs(exact_j0) > std::abs(exact_j1) ? exact_j0 / current : exact_j1 / next;
+
+    value = j_l * scale;
+    if (l == 0) {
+        derivative = -next * scale;
+    } else {
+        derivative = j_l_minus_1 * scale - (l + 1.0) / x * value;
+    }
+}
+
+// Zeros of f' on (x_begin, x_max]; evaluate(x, f, f') returns the function
+// and its derivative, second(x, f, f') the second derivative from the ODE
+template <typename Evaluate, typename Second>
+std::vector<double> findDerivativeZeros(double x_begin, double x_max, Evaluate evaluate, Second second) {
+    std::vector<double> zeros;
+    double a = x_begin;
+    double value, derivative_a;
+    evaluate(a, value, derivative_a);
+
+    while (a < x_max) {
+        // Allow a root slightly past the ceiling so it is refined and then tested
+        const double b = a + kZeroScanStep;
+        double derivative_b;
+        evaluate(b, value, derivative_b);
+
+        if (derivative_a == 0.0 && a > x_begin) {
+            zeros.push_back(a);
+        } else if ((derivative_a < 0.0) != (derivative_b < 0.0) && derivative_b != 0.0) {
+            // Safeguarded Newton on [lo, hi]
+            double lo = a, hi = b;
+            const bool rising = derivative_a < 0.0;
+            double x = 0.5 * (lo + hi);
+            for (int iteration = 0; iteration < kMaxNewtonIterations; ++iteration) {
+                double f, fp;
+                evaluate(x, f, fp);
+                if ((fp < 0.0) == rising) {
+                    lo = x;
+                } else {
+                    hi = x;
+                }
+                const double fpp = second(x, f, fp);
+                double candidate = (fpp != 0.0) ? x - fp / fpp : 0.5 * (lo + hi);
+                if (!(candidate > lo && candidate < hi)) {
+                    candidate = 0.5 * (lo + hi);
+                }
+                const bool converged = std::abs(candidate - x) <= kZeroTolerance * std::max(1.0, x);
+                x = candidate;
+                if (converged || hi - lo <= kZeroTolerance * std::max(1.0, x)) {
+                    break;
+                }
+            }
+            if (x <= x_max) {
+                zeros.push_back(x);
+            }
+        }
+
+        a = b;
+        derivative_a = derivative_b;
+    }
+    return zeros;
+}
+
+struct CachedModes {
+    double max_frequency;
+    DomeModeList modes;
+    uint64_t last_used;     // cache_clock at the last hit or store, for LRU eviction
+};
+
+using GeometryKey = std::tuple<int, double, double, double>;
+
+std::mutex cache_mutex;
+std::map<GeometryKey, CachedModes> mode_cache;
+uint64_t cache_clock = 0;
+
+} // namespace
+
+double besselJ(int n, double x) {
+    double value, derivative;
+    besselJWithDerivative(n, x, value, derivative);
+    return value;
+}
+
+double besselJPrime(int n, double x) {
+    double value, derivative;
+    besselJWithDerivative(n, x, value, derivative);
+    return derivative;
+}
+
+double sphericalBesselJ(int l, double x) {
+    double value, derivative;
+    sphericalBesselWithDerivative(l, x, value, derivative);
+    return value;
+}
+
+double sphericalBesselJPrime(int l, double x) {
+    double value, derivative;
+    sphericalBesselWithDerivative(l, x, value, derivative);
+    return derivative;
+}
+
+std::vector<double> besselJPrimeZeros(int n, double x_max) {
+    // Every positive zero of J_n' lies above n (n >= 1); J_0' = -J_1 starts at 3.83
+    const double x_begin = std::max(0.5, static_cast<double>(n));
+    if (x_begin >= x_max) {
+        return {};
+    }
+    return findDerivativeZeros(
+        x_begin, x_max,
+        [n](double x, double& f, double& fp) { besselJWithDerivative(n, x, f, fp); },
+        // Bessel equation: J'' = -J'/x - (1 - n^2/x^2) J
+        [n](double x, double f, double fp) {
+            return -fp / x - (1.0 - static_cast<double>(n) * n / (x * x)) * f;
+        });
+}
+
+std::vector<double> sphericalBesselJPrimeZeros(int l, double x_max) {
+    const double x_begin = std::max(0.5, static_cast<double>(l));
+    if (x_begin >= x_max) {
+        return {};
+    }
+    return findDerivativeZeros(
+        x_begin, x_max,
+        [l](double x, double& f, double& fp) { sphericalBesselWithDerivative(l, x, f, fp); },
+        // Spherical Bessel equation: j'' = -2j'/x - (1 - l(l+1)/x^2) j
+        [l](double x, double f, double fp) {
+            return -2.0 * fp / x - (1.0 - static_cast<double>(l) * (l + 1) / (x * x)) * f;
+        });
+}
+
+std::vector<DomeMode> DomeModalSolver::computeModes(DomeShapeModel model, double radius, double height,
+                                                    double max_frequency, double speed_of_sound) {
+    std::vector<DomeMode> modes;
+    if (radius <= 0.0 || max_frequency <= 0.0 || speed_of_sound <= 0.0) {
+        return modes;
+    }
+
+    const double k_max = 2.0 * M_PI * max_frequency / speed_of_sound;
+    const double x_max = k_max * radius;
+    const double to_frequency = speed_of_sound / (2.0 * M_PI);
+
+    if (model == DomeShapeModel::CYLINDER) {
+        if (height <= 0.0) {
+            return modes;
+        }
+        const double axial_step = M_PI / height;
+        for (int n = 0; n <= static_cast<int>(x_max); ++n) {
+            std::vector<double> zeros = besselJPrimeZeros(n, x_max);
+            if (n == 0) {
+                // Trivial zero: purely axial modes
+                zeros.insert(zeros.begin(), 0.0);
+            } else if (zeros.empty()) {
+                // The first zero grows with n, so higher orders have none either
+                break;
+            }
+
+            for (size_t m = 0; m < zeros.size(); ++m) {
+                const double k_radial = zeros[m] / radius;
+                for (int p = 0;; ++p) {
+                    const double k_axial = p * axial_step;
+                    const double k = std::sqrt(k_radial * k_radial + k_axial * k_axial);
+                    if (k > k_max) {
+                        break;
+                    }
+                    if (k == 0.0) {
+                        continue;
+                    }
+                    const int radial = (n == 0) ? static_cast<int>(m) : static_cast<int>(m) + 1;
+                    modes.push_back(DomeMode{to_frequency * k, n, radial, p, n == 0 ? 1 : 2});
+                }
+            }
+        }
+    } else {
+        for (int l = 0; l <= static_cast<int>(x_max); ++l) {
+            const std::vector<double> zeros = sphericalBesselJPrimeZeros(l, x_max);
+            // l = 0 starts at 4.49, above the l = 1 zero at 2.08
+            if (zeros.empty() && l > 0) {
+                break;
+            }
+            for (size_t s = 0; s < zeros.size(); ++s) {
+                const int multiplicity = (model == DomeShapeModel::SPHERE) ? 2 * l + 1 : l + 1;
+                modes.push_back(DomeMode{to_frequency * zeros[s] / radius, l,
+                                         static_cast<int>(s) + 1, 0, multiplicity});
+            }
+        }
+    }
+
+    std::stable_sort(modes.begin(), modes.end(),
+                     [](const DomeMode& a, const DomeMode& b) { return a.frequency < b.frequency; });
+    return modes;
+}
+
+DomeModeList DomeModalSolver::getModes(DomeShapeModel model, double radius, double height,
+                                       double max_frequency, double speed_of_sound) {
+    const GeometryKey key(static_cast<int>(model), radius,
+                          model == DomeShapeModel::CYLINDER ? height : 0.0, speed_of_sound);
+
+    DomeModeList cached;
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = mode_cache.find(key);
+        if (it != mode_cache.end() && it->second.max_frequency >= max_frequency) {
+            it->second.last_used = ++cache_clock;
+            if (it->second.max_frequency == max_frequency) {
+                return it->second.modes;
+            }
+            cached = it->second.modes;
+        }
+    }
+
+    if (cached) {
+        // Lower ceiling: the sorted prefix of the cached list
+        auto end = std::upper_bound(cached->begin(), cached->end(), max_frequency,
+                                    [](double f, const DomeMode& mode) { return f < mode.frequency; });
+        return std::make_shared<const std::vector<DomeMode>>(cached->begin(), end);
+    }
+
+    // Solve outside the lock so other geometries are not blocked
+    auto modes = std::make_shared<const std::vector<DomeMode>>(
+        computeModes(model, radius, height, max_frequency, speed_of_sound));
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = mode_cache.find(key);
+    if (it == mode_cache.end()) {
+        if (mode_cache.size() >= kMaxCachedGeometries) {
+            // Evict the least recently used geometry (the cache is small, a scan is enough)
+            auto oldest = std::min_element(mode_cache.begin(), mode_cache.end(),
+                                           [](const auto& a, const auto& b) {
+                                               return a.second.last_used < b.second.last_used;
+                                           });
+            mode_cache.erase(oldest);
+        }
+        mode_cache.emplace(key, CachedModes{max_frequency, modes, ++cache_clock});
+    } else if (it->second.max_frequency < max_frequency) {
+        it->second = CachedModes{max_frequency, modes, ++cache_clock};
+    }
+    return modes;
+}
+
+void DomeModalSolver::clearCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    mode_cache.clear();
+}
+
+size_t DomeModalSolver::getCacheSize() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return mode_cache.size();
+}
+
+} // namespace AnantaSound
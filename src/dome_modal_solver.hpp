@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Модель геометрии купола для модального расчета
+enum class DomeShapeModel {
+    CYLINDER,       // Цилиндр радиуса R и высоты H с жесткими стенками
+    HEMISPHERE,     // Полусфера радиуса R на жестком полу (высота не учитывается)
+    SPHERE          // Замкнутая сфера радиуса R (высота не учитывается)
+};
+
+// Собственная мода помещения.
+// Цилиндр: order = n (угловой), radial = m (номер нуля J'_n, 0 - тривиальный
+// нуль при n = 0), axial = p. Сфера и полусфера: order = l, radial = номер
+// нуля j'_l, axial = 0. multiplicity - число вырожденных мод с этой частотой.
+struct DomeMode {
+    double frequency;
+    int order;
+    int radial;
+    int axial;
+    int multiplicity;
+};
+
+using DomeModeList = std::shared_ptr<const std::vector<DomeMode>>;
+
+// Функции Бесселя целого порядка, x >= 0
+double besselJ(int n, double x);
+double besselJPrime(int n, double x);
+double sphericalBesselJ(int l, double x);
+double sphericalBesselJPrime(int l, double x);
+
+// Положительные нули J'_n(x) и j'_l(x) на (0, x_max] по возрастанию
+std::vector<double> besselJPrimeZeros(int n, double x_max);
+std::vector<double> sphericalBesselJPrimeZeros(int l, double x_max);
+
+// Модальный расчет купола.
+// Цилиндр: f = c/2π * sqrt((j'_nm / R)^2 + (pπ / H)^2).
+// Сфера: f = c/2π * j'_ln / R с кратностью 2l + 1; у полусферы жесткий
+// пол оставляет l + 1 симметричных мод. Нули ищутся сканированием с шагом
+// меньше расстояния между ними и уточняются методом Ньютона с защитой
+// бисекцией.
+class DomeModalSolver {
+public:
+    static constexpr double kDefaultSpeedOfSound = 343.0;
+
+    // Все моды до max_frequency (включительно), по возрастанию частоты
+    static std::vector<DomeMode> computeModes(DomeShapeModel model, double radius, double height,
+                                              double max_frequency,
+                                              double speed_of_sound = kDefaultSpeedOfSound);
+
+    // То же с кэшем на геометрию: повторный запрос с тем же или меньшим
+    // потолком не пересчитывает нули. Кэш хранит до 16 геометрий и вытесняет
+    // дольше всех не запрашивавшуюся (LRU). Потокобезопасно.
+    static DomeModeList getModes(DomeShapeModel model, double radius, double height,
+                                 double max_frequency,
+                                 double speed_of_sound = kDefaultSpeedOfSound);
+
+    static void clearCache();
+    static size_t getCacheSize();
+};
+
+} // namespace AnantaSound
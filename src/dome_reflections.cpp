@@ -0,0 +1,166 @@
+#include "dome_reflections.hpp"
+#include <array>
+#include <cmath>
+#include <utility>
+
+namespace AnantaSound {
+
+namespace {
+
+// Angular samples of the path-length derivative when bracketing the
+// stationary points on the shell circle, and the root refinement budget
+constexpr int kShellSamples = 96;
+constexpr int kRefinementSteps = 48;
+constexpr double kAngleTolerance = 1e-13;
+
+inline double dot3(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Unit vector along `direction` with its component along `axis` removed; false if degenerate
+bool orthonormalize(const double direction[3], const double axis[3], double out[3]) {
+    const double projection = dot3(direction, axis);
+    for (int i = 0; i < 3; ++i) {
+        out[i] = direction[i] - projection * axis[i];
+    }
+    const double length = std::sqrt(dot3(out, out));
+    if (length < 1e-9) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        out[i] /= length;
+    }
+    return true;
+}
+
+// Stationary points on the circle of the given radius in the plane (e1, e2)
+// through the centre; source and receiver are given in that basis,
+// out_of_plane is their distance along the plane normal
+void addCircleReflections(DomeShapeModel shape, double radius, const double source[2], const double receiver[2],
+                          double out_of_plane, const double e1[3], const double e2[3],
+                          std::vector<double>& lengths) {
+    // dL/dψ for the wall point P(ψ) = R (cos ψ, sin ψ): sum of the unit vectors
+    // towards P projected on the tangent; zero at a specular reflection
+    auto derivative_at = [&](double c, double sn) {
+        const double px = radius * c;
+        const double py = radius * sn;
+        const double sx = px - source[0], sy = py - source[1];
+        const double rx = px - receiver[0], ry = py - receiver[1];
+        const double ls = std::max(std::hypot(sx, sy), 1e-12);
+        const double lr = std::max(std::hypot(rx, ry), 1e-12);
+        return (-sn * sx + c * sy) / ls + (-sn * rx + c * ry) / lr;
+    };
+    auto derivative = [&](double psi) {
+        return derivative_at(std::cos(psi), std::sin(psi));
+    };
+
+    // The sample angles are the same for every pair
+    static const auto samples = [] {
+        std::array<std::pair<double, double>, kShellSamples + 1> table;
+        for (int i = 0; i <= kShellSamples; ++i) {
+            const double psi = 2.0 * M_PI * i / kShellSamples;
+            table[i] = {std::cos(psi), std::sin(psi)};
+        }
+        return table;
+    }();
+
+    const double step = 2.0 * M_PI / kShellSamples;
+    double previous = derivative_at(samples[0].first, samples[0].second);
+    for (int i = 1; i <= kShellSamples; ++i) {
+        double low = (i - 1) * step;
+        double high = i * step;
+        const double current = derivative_at(samples[i].first, samples[i].second);
+        if ((previous < 0.0) == (current < 0.0) && current != 0.0) {
+            previous = current;
+            continue;
+        }
+
+        // Illinois false position: superlinear on the smooth derivative, and the
+        // bracket is kept, so it cannot wander to a neighbouring root
+        double low_value = previous;
+        double high_value = current;
+        double psi = 0.5 * (low + high);
+        int retained_side = 0;
+        for (int iteration = 0; iteration < kRefinementSteps; ++iteration) {
+            const double estimate = high_value == low_value
+                ? 0.5 * (low + high)
+                : (low * high_value - high * low_value) / (high_value - low_value);
+            const bool converged = std::abs(estimate - psi) < kAngleTolerance;
+            psi = estimate;
+            const double value = derivative(psi);
+            if (value == 0.0 || converged) {
+                break;
+            }
+            if ((value < 0.0) == (low_value < 0.0)) {
+                low = psi;
+                low_value = value;
+                if (retained_side == -1) {
+                    high_value *= 0.5;
+                }
+                retained_side = -1;
+            } else {
+                high = psi;
+                high_value = value;
+                if (retained_side == 1) {
+                    low_value *= 0.5;
+                }
+                retained_side = 1;
+            }
+        }
+        previous = current;
+
+        const double c = std::cos(psi);
+        const double sn = std::sin(psi);
+
+        // The hemisphere shell exists only above the floor
+        if (shape == DomeShapeModel::HEMISPHERE && radius * (c * e1[2] + sn * e2[2]) < 0.0) {
+            continue;
+        }
+
+        const double px = radius * c;
+        const double py = radius * sn;
+        const double in_plane = std::hypot(px - source[0], py - source[1]) +
+                                std::hypot(px - receiver[0], py - receiver[1]);
+        lengths.push_back(std::hypot(in_plane, out_of_plane));
+    }
+}
+
+} // namespace
+
+void findShellReflections(DomeShapeModel shape, double radius, const double s[3], const double r[3],
+                          std::vector<double>& lengths) {
+    if (shape == DomeShapeModel::CYLINDER) {
+        // The wall is vertical: reflections are found in the horizontal projection
+        const double e1[3] = {1.0, 0.0, 0.0};
+        const double e2[3] = {0.0, 1.0, 0.0};
+        const double source_2d[2] = {s[0], s[1]};
+        const double receiver_2d[2] = {r[0], r[1]};
+        addCircleReflections(shape, radius, source_2d, receiver_2d, std::abs(s[2] - r[2]), e1, e2, lengths);
+        return;
+    }
+
+    // Specular points lie in the plane through the centre, source and receiver;
+    // when they are collinear any plane through the line will do, a vertical one is preferred
+    const double up[3] = {0.0, 0.0, 1.0};
+    const double side[3] = {1.0, 0.0, 0.0};
+    double e1[3], e2[3];
+    const double* anchor = dot3(s, s) > 1e-12 ? s : r;
+    const double anchor_length = std::sqrt(dot3(anchor, anchor));
+    if (anchor_length > 1e-6) {
+        for (int i = 0; i < 3; ++i) {
+            e1[i] = anchor[i] / anchor_length;
+        }
+    } else {
+        e1[0] = 1.0;
+        e1[1] = 0.0;
+        e1[2] = 0.0;
+    }
+    if (!orthonormalize(anchor == s ? r : s, e1, e2) && !orthonormalize(up, e1, e2)) {
+        orthonormalize(side, e1, e2);
+    }
+    const double source_2d[2] = {dot3(s, e1), dot3(s, e2)};
+    const double receiver_2d[2] = {dot3(r, e1), dot3(r, e2)};
+    addCircleReflections(shape, radius, source_2d, receiver_2d, 0.0, e1, e2, lengths);
+}
+
+} // namespace AnantaSound
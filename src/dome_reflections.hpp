@@ -0,0 +1,18 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include <vector>
+
+namespace AnantaSound {
+
+// Зеркальные отражения первого порядка от кривой оболочки купола (сфера,
+// полусфера, боковая стенка цилиндра) для точек внутри объема. Отражения -
+// стационарные точки длины пути на окружности радиуса купола в плоскости
+// центра, источника и приемника (у цилиндра - в горизонтальной проекции,
+// с вертикальным расстоянием между точками). У полусферы учитываются только
+// точки над полом. Длины путей (м) добавляются в lengths в порядке обхода
+// окружности.
+void findShellReflections(DomeShapeModel shape, double radius, const double source[3], const double receiver[3],
+                          std::vector<double>& lengths);
+
+} // namespace AnantaSound
@@ -0,0 +1,222 @@
+#include "entanglement_graph.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace AnantaSound {
+
+EntanglementGraph::EntanglementGraph()
+    : edges_stale_(false), clusters_dirty_(false), adjacency_dirty_(false) {
+}
+
+uint64_t EntanglementGraph::edgeKey(NodeId a, NodeId b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+void EntanglementGraph::ensureCapacity(NodeId node) {
+    if (node < present_.size()) {
+        return;
+    }
+    const size_t old_size = present_.size();
+    present_.resize(static_cast<size_t>(node) + 1, kAbsent);
+    parent_.resize(present_.size());
+    members_.resize(present_.size());
+    for (size_t i = old_size; i < present_.size(); ++i) {
+        parent_[i] = static_cast<NodeId>(i);
+    }
+}
+
+void EntanglementGraph::addNode(NodeId node) {
+    ensureCapacity(node);
+    if (present_[node] == kPresent) {
+        return;
+    }
+    if (present_[node] == kRemoved) {
+        // The id is reused: its old edges must not come back with it
+        purgeRemovedEdges();
+    }
+    present_[node] = kPresent;
+    parent_[node] = node;
+    members_[node].assign(1, node);
+    adjacency_dirty_ = true;
+}
+
+void EntanglementGraph::removeNode(NodeId node) {
+    if (!contains(node)) {
+        return;
+    }
+
+    // Incident edges stay in edges_ until the next query purges all removed
+    // nodes in one pass
+    present_[node] = kRemoved;
+    members_[node].clear();
+    edges_stale_ = true;
+
+    // Union-find cannot split sets; recompute components lazily
+    clusters_dirty_ = true;
+    adjacency_dirty_ = true;
+}
+
+bool EntanglementGraph::contains(NodeId node) const {
+    return node < present_.size() && present_[node] == kPresent;
+}
+
+bool EntanglementGraph::addEdge(NodeId a, NodeId b) {
+    if (a == b) {
+        return false;
+    }
+    addNode(a);
+    addNode(b);
+    if (!edges_.insert(edgeKey(a, b)).second) {
+        return false;
+    }
+    if (!clusters_dirty_) {
+        unite(a, b);
+    }
+    adjacency_dirty_ = true;
+    return true;
+}
+
+bool EntanglementGraph::hasEdge(NodeId a, NodeId b) const {
+    return a != b && contains(a) && contains(b) && edges_.count(edgeKey(a, b)) != 0;
+}
+
+size_t EntanglementGraph::getEdgeCount() {
+    if (edges_stale_) {
+        purgeRemovedEdges();
+    }
+    return edges_.size();
+}
+
+const EntanglementGraph::NodeId* EntanglementGraph::neighbors(NodeId node, size_t& count) {
+    if (adjacency_dirty_) {
+        rebuildAdjacency();
+    }
+    if (node + 1 >= adjacency_offsets_.size()) {
+        count = 0;
+        return nullptr;
+    }
+    count = adjacency_offsets_[node + 1] - adjacency_offsets_[node];
+    return adjacency_.data() + adjacency_offsets_[node];
+}
+
+EntanglementGraph::NodeId EntanglementGraph::clusterOf(NodeId node) {
+    addNode(node);
+    if (clusters_dirty_) {
+        rebuildClusters();
+    }
+    return find(node);
+}
+
+const std::vector<EntanglementGraph::NodeId>& EntanglementGraph::clusterMembers(NodeId node) {
+    return members_[clusterOf(node)];
+}
+
+void EntanglementGraph::clear() {
+    edges_.clear();
+    present_.clear();
+    parent_.clear();
+    members_.clear();
+    adjacency_offsets_.clear();
+    adjacency_.clear();
+    edges_stale_ = false;
+    clusters_dirty_ = false;
+    adjacency_dirty_ = false;
+}
+
+EntanglementGraph::NodeId EntanglementGraph::find(NodeId node) {
+    NodeId root = node;
+    while (parent_[root] != root) {
+        root = parent_[root];
+    }
+    // Path compression
+    while (parent_[node] != root) {
+        NodeId next = parent_[node];
+        parent_[node] = root;
+        node = next;
+    }
+    return root;
+}
+
+void EntanglementGraph::unite(NodeId a, NodeId b) {
+    NodeId root_a = find(a);
+    NodeId root_b = find(b);
+    if (root_a == root_b) {
+        return;
+    }
+    // Union by size: the smaller member list is moved, so each node is
+    // moved O(log n) times in total
+    if (members_[root_a].size() < members_[root_b].size()) {
+        std::swap(root_a, root_b);
+    }
+    parent_[root_b] = root_a;
+    auto& target = members_[root_a];
+    auto& source = members_[root_b];
+    target.insert(target.end(), source.begin(), source.end());
+    source.clear();
+    source.shrink_to_fit();
+}
+
+void EntanglementGraph::purgeRemovedEdges() {
+    for (auto it = edges_.begin(); it != edges_.end();) {
+        const NodeId a = static_cast<NodeId>(*it >> 32);
+        const NodeId b = static_cast<NodeId>(*it);
+        if (present_[a] == kPresent && present_[b] == kPresent) {
+            ++it;
+        } else {
+            it = edges_.erase(it);
+        }
+    }
+    for (auto& state : present_) {
+        if (state == kRemoved) {
+            state = kAbsent;
+        }
+    }
+    edges_stale_ = false;
+}
+
+void EntanglementGraph::rebuildClusters() {
+    if (edges_stale_) {
+        purgeRemovedEdges();
+    }
+    for (size_t i = 0; i < present_.size(); ++i) {
+        parent_[i] = static_cast<NodeId>(i);
+        members_[i].clear();
+        if (present_[i] == kPresent) {
+            members_[i].push_back(static_cast<NodeId>(i));
+        }
+    }
+    clusters_dirty_ = false;
+    for (uint64_t key : edges_) {
+        unite(static_cast<NodeId>(key >> 32), static_cast<NodeId>(key));
+    }
+}
+
+void EntanglementGraph::rebuildAdjacency() {
+    if (edges_stale_) {
+        purgeRemovedEdges();
+    }
+    // Counting sort of both edge directions into CSR
+    adjacency_offsets_.assign(present_.size() + 1, 0);
+    for (uint64_t key : edges_) {
+        ++adjacency_offsets_[static_cast<NodeId>(key >> 32) + 1];
+        ++adjacency_offsets_[static_cast<NodeId>(key) + 1];
+    }
+    for (size_t i = 1; i < adjacency_offsets_.size(); ++i) {
+        adjacency_offsets_[i] += adjacency_offsets_[i - 1];
+    }
+
+    adjacency_.resize(2 * edges_.size());
+    std::vector<uint32_t> cursor(adjacency_offsets_.begin(), adjacency_offsets_.end() - 1);
+    for (uint64_t key : edges_) {
+        const NodeId a = static_cast<NodeId>(key >> 32);
+        const NodeId b = static_cast<NodeId>(key);
+        adjacency_[cursor[a]++] = b;
+        adjacency_[cursor[b]++] = a;
+    }
+    adjacency_dirty_ = false;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Граф квантовой запутанности между источниками.
+// Узлы - стабильные идентификаторы источников. Ребра хранятся без повторов;
+// смежность строится в формате CSR при первом обращении после изменения.
+// Удаление узла O(1): его ребра вычищаются одним проходом при следующем
+// запросе, поэтому удаление k узлов стоит одну перестройку, а не k.
+// Кластеры (компоненты связности) поддерживаются системой непересекающихся
+// множеств с сжатием путей и объединением по размеру: запрос кластера
+// стоит O(α(n)), список членов кластера хранится у его корня.
+class EntanglementGraph {
+public:
+    using NodeId = uint32_t;
+
+private:
+    // Состояние узла; у kRemoved ребра еще лежат в edges_
+    enum NodeState : uint8_t { kAbsent = 0, kPresent = 1, kRemoved = 2 };
+
+    std::unordered_set<uint64_t> edges_;             // Ключ ребра: (min << 32) | max
+    std::vector<uint8_t> present_;                  // NodeState узла
+    bool edges_stale_;                              // Есть ребра удаленных узлов
+
+    // Непересекающиеся множества
+    std::vector<NodeId> parent_;
+    std::vector<std::vector<NodeId>> members_;      // Члены кластера (только у корня)
+    bool clusters_dirty_;                           // Нужна перестройка после удаления
+
+    // CSR-смежность
+    std::vector<uint32_t> adjacency_offsets_;
+    std::vector<NodeId> adjacency_;
+    bool adjacency_dirty_;
+
+public:
+    EntanglementGraph();
+
+    // Добавить узел (одиночный кластер); повторный вызов ничего не меняет
+    void addNode(NodeId node);
+
+    // Удалить узел и все его ребра
+    void removeNode(NodeId node);
+
+    bool contains(NodeId node) const;
+
+    // Добавить ребро; false, если оно уже есть или узлы совпадают
+    bool addEdge(NodeId a, NodeId b);
+    bool hasEdge(NodeId a, NodeId b) const;
+
+    // Количество уникальных ребер
+    size_t getEdgeCount();
+
+    // Соседи узла (указатель и количество, действительны до следующего изменения)
+    const NodeId* neighbors(NodeId node, size_t& count);
+
+    // Представитель кластера узла
+    NodeId clusterOf(NodeId node);
+
+    // Члены кластера узла (ссылка действительна до следующего изменения)
+    const std::vector<NodeId>& clusterMembers(NodeId node);
+
+    void clear();
+
+private:
+    static uint64_t edgeKey(NodeId a, NodeId b);
+    void ensureCapacity(NodeId node);
+    NodeId find(NodeId node);
+    void unite(NodeId a, NodeId b);
+    void purgeRemovedEdges();
+    void rebuildClusters();
+    void rebuildAdjacency();
+};
+
+} // namespace AnantaSound
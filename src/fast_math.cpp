@@ -0,0 +1,158 @@
+#include "fast_math.hpp"
+#include <atomic>
+
+namespace AnantaSound {
+
+namespace {
+
+std::atomic<MathAccuracy> g_default_accuracy{MathAccuracy::HIGH};
+
+template <bool High>
+void sinCosBatchKernel(const double* x, double* s, double* c, size_t count) {
+    using namespace FastMathDetail;
+    
+    // Branch-free body so the compiler can vectorize the whole loop. NaN and
+    // huge arguments are masked to 0 so the quadrant cast stays defined
+    for (size_t i = 0; i < count; ++i) {
+        double xi = std::abs(x[i]) < kMaxReducibleArgument ? x[i] : 0.0;
+        double q = roundToInteger(xi * kTwoOverPi);
+        double r, rs, rc;
+        if (High) {
+            r = ((xi - q * kPiOver2Part1) - q * kPiOver2Part2) - q * kPiOver2Part3;
+            sinCosKernelHigh(r, rs, rc);
+        } else {
+            r = (xi - q * kPiOver2Part1) - q * (kPiOver2Part2 + kPiOver2Part3);
+            sinCosKernelFast(r, rs, rc);
+        }
+        applyQuadrant(q, rs, rc, s[i], c[i]);
+    }
+    
+    // Rare huge arguments are redone with the library functions
+    for (size_t i = 0; i < count; ++i) {
+        if (!(std::abs(x[i]) < kMaxReducibleArgument)) {
+            s[i] = std::sin(x[i]);
+            c[i] = std::cos(x[i]);
+        }
+    }
+}
+
+// atan on [0, 1]
+double atanUnitHigh(double x) {
+    // Cephes atan: reduce to |x| <= 0.66 and use a rational approximation
+    constexpr double kMoreBits = 6.123233995736765886130e-17;
+    double y = 0.0;
+    double extra = 0.0;
+    if (x > 0.66) {
+        y = M_PI / 4.0;
+        extra = 0.5 * kMoreBits;
+        x = (x - 1.0) / (x + 1.0);
+    }
+    
+    double z = x * x;
+    double p = (((-8.750608600031904122785e-01 * z - 1.615753718733365076637e+01) * z
+                 - 7.500855792314704667340e+01) * z - 1.228866684490136173410e+02) * z
+               - 6.485021904942025371773e+01;
+    double q = ((((z + 2.485846490142306297962e+01) * z + 1.650270098316988542046e+02) * z
+                 + 4.328810604912902668951e+02) * z + 4.853903996359136964868e+02) * z
+               + 1.945506571482613964425e+02;
+    
+    return y + (x + x * z * p / q + extra);
+}
+
+double atanUnitFast(double x) {
+    // Abramowitz & Stegun 4.4.49, |error| <= 1e-5
+    double z = x * x;
+    return x * (0.9998660 + z * (-0.3302995 + z * (0.1801410 + z * (-0.0851330 + z * 0.0208351))));
+}
+
+} // namespace
+
+void setDefaultMathAccuracy(MathAccuracy accuracy) {
+    g_default_accuracy.store(accuracy);
+}
+
+MathAccuracy getDefaultMathAccuracy() {
+    return g_default_accuracy.load();
+}
+
+void fastSinCosBatch(const double* x, double* s, double* c, size_t count, MathAccuracy accuracy) {
+    switch (accuracy) {
+        case MathAccuracy::EXACT:
+            for (size_t i = 0; i < count; ++i) {
+                s[i] = std::sin(x[i]);
+                c[i] = std::cos(x[i]);
+            }
+            break;
+        case MathAccuracy::HIGH:
+            sinCosBatchKernel<true>(x, s, c, count);
+            break;
+        case MathAccuracy::FAST:
+            sinCosBatchKernel<false>(x, s, c, count);
+            break;
+    }
+}
+
+double fastAtan2(double y, double x, MathAccuracy accuracy) {
+    if (accuracy == MathAccuracy::EXACT || std::isnan(x) || std::isnan(y) ||
+        std::isinf(x) || std::isinf(y)) {
+        return std::atan2(y, x);
+    }
+    
+    double ax = std::abs(x);
+    double ay = std::abs(y);
+    if (ax == 0.0 && ay == 0.0) {
+        return std::atan2(y, x); // keeps the signed-zero conventions of std::arg
+    }
+    
+    // Reduce to a ratio in [0, 1]
+    bool swapped = ay > ax;
+    double ratio = swapped ? ax / ay : ay / ax;
+    double angle = (accuracy == MathAccuracy::HIGH) ? atanUnitHigh(ratio) : atanUnitFast(ratio);
+    
+    if (swapped) angle = M_PI / 2.0 - angle;
+    if (x < 0.0) angle = M_PI - angle;
+    return (y < 0.0) ? -angle : angle;
+}
+
+// PhasorRotator implementation
+PhasorRotator::PhasorRotator(double phase, double phase_increment)
+    : re_(1.0), im_(0.0), step_re_(1.0), step_im_(0.0), steps_since_normalize_(0) {
+    reset(phase, phase_increment);
+}
+
+void PhasorRotator::reset(double phase, double phase_increment) {
+    re_ = std::cos(phase);
+    im_ = std::sin(phase);
+    steps_since_normalize_ = 0;
+    setPhaseIncrement(phase_increment);
+}
+
+void PhasorRotator::setPhaseIncrement(double phase_increment) {
+    step_re_ = std::cos(phase_increment);
+    step_im_ = std::sin(phase_increment);
+}
+
+void PhasorRotator::generate(double* re, double* im, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        re[i] = re_;
+        im[i] = im_;
+        advance();
+    }
+}
+
+void PhasorRotator::normalize() {
+    // One Newton step towards |z| = 1; the drift is always tiny
+    double scale = 0.5 * (3.0 - (re_ * re_ + im_ * im_));
+    re_ *= scale;
+    im_ *= scale;
+    steps_since_normalize_ = 0;
+}
+
+void rotatePhasors(std::complex<double>* phasors, size_t count, double angle, MathAccuracy accuracy) {
+    std::complex<double> rotation = fastExpI(angle, accuracy);
+    for (size_t i = 0; i < count; ++i) {
+        phasors[i] *= rotation;
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <complex>
+#include <cmath>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Режимы точности быстрых тригонометрических функций
+enum class MathAccuracy {
+    EXACT,  // Стандартная библиотека (std::sin, std::cos, std::atan2)
+    HIGH,   // Полиномы двойной точности, погрешность ~1e-15
+    FAST    // Укороченные полиномы, погрешность до ~1e-5 (визуализация)
+};
+
+// Точность по умолчанию для новых объектов
+void setDefaultMathAccuracy(MathAccuracy accuracy);
+MathAccuracy getDefaultMathAccuracy();
+
+namespace FastMathDetail {
+
+// π/2, разложенное на три части для точного приведения аргумента (Cody-Waite)
+constexpr double kPiOver2Part1 = 1.57079625129699707031e+00;
+constexpr double kPiOver2Part2 = 7.54978941586159635335e-08;
+constexpr double kPiOver2Part3 = 5.39030285815811905290e-15;
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+
+// Выше этого порога приведение теряет точность, используется std::sin/std::cos
+constexpr double kMaxReducibleArgument = 1.0e7;
+
+// Округление к ближайшему целому без вызова библиотеки (|x| < 2^51)
+inline double roundToInteger(double x) {
+    constexpr double kRoundingMagic = 6755399441055744.0; // 1.5 * 2^52
+    return (x + kRoundingMagic) - kRoundingMagic;
+}
+
+// sin и cos приведенного аргумента r ∈ [-π/4, π/4]
+inline void sinCosKernelHigh(double r, double& s, double& c) {
+    double z = r * r;
+    s = r + r * z * (-1.66666666666666307295e-01 + z * (8.33333333332211858878e-03 +
+        z * (-1.98412698295895385996e-04 + z * (2.75573136213857245213e-06 +
+        z * (-2.50507477628578072866e-08 + z * 1.58962301576546568060e-10)))));
+    c = 1.0 - 0.5 * z + z * z * (4.16666666666665929218e-02 + z * (-1.38888888888730564116e-03 +
+        z * (2.48015872888517045348e-05 + z * (-2.75573141792967388112e-07 +
+        z * (2.08757008419747316778e-09 + z * -1.13585365213876817300e-11)))));
+}
+
+inline void sinCosKernelFast(double r, double& s, double& c) {
+    double z = r * r;
+    s = r + r * z * (-1.6666654611e-01 + z * (8.3321608736e-03 + z * -1.9515295891e-04));
+    c = 1.0 - 0.5 * z + z * z * (4.166664568298827e-02 + z * (-1.388731625493765e-03 +
+        z * 2.443315711809948e-05));
+}
+
+// Восстановление квадранта: (sin, cos) для x = r + q·π/2.
+// q - целое с |q| < 2^31 (аргумент меньше kMaxReducibleArgument)
+inline void applyQuadrant(double q, double s, double c, double& sin_out, double& cos_out) {
+    int quadrant = static_cast<int>(q) & 3;
+    double swapped_s = (quadrant & 1) ? c : s;
+    double swapped_c = (quadrant & 1) ? s : c;
+    sin_out = (quadrant & 2) ? -swapped_s : swapped_s;
+    cos_out = ((quadrant + 1) & 2) ? -swapped_c : swapped_c;
+}
+
+} // namespace FastMathDetail
+
+// Одновременное вычисление синуса и косинуса
+inline void fastSinCos(double x, double& s, double& c, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    using namespace FastMathDetail;
+    
+    if (accuracy == MathAccuracy::EXACT || !(std::abs(x) < kMaxReducibleArgument)) {
+        s = std::sin(x);
+        c = std::cos(x);
+        return;
+    }
+    
+    double q = roundToInteger(x * kTwoOverPi);
+    double rs, rc;
+    if (accuracy == MathAccuracy::HIGH) {
+        double r = ((x - q * kPiOver2Part1) - q * kPiOver2Part2) - q * kPiOver2Part3;
+        sinCosKernelHigh(r, rs, rc);
+    } else {
+        double r = (x - q * kPiOver2Part1) - q * (kPiOver2Part2 + kPiOver2Part3);
+        sinCosKernelFast(r, rs, rc);
+    }
+    applyQuadrant(q, rs, rc, s, c);
+}
+
+inline double fastSin(double x, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    double s, c;
+    fastSinCos(x, s, c, accuracy);
+    return s;
+}
+
+inline double fastCos(double x, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    double s, c;
+    fastSinCos(x, s, c, accuracy);
+    return c;
+}
+
+// exp(i·phase) - единичный фазор, замена std::exp(std::complex<double>(0, phase))
+inline std::complex<double> fastExpI(double phase, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    double s, c;
+    fastSinCos(phase, s, c, accuracy);
+    return std::complex<double>(c, s);
+}
+
+// magnitude·exp(i·phase), замена std::polar
+inline std::complex<double> fastPolar(double magnitude, double phase, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    double s, c;
+    fastSinCos(phase, s, c, accuracy);
+    return std::complex<double>(magnitude * c, magnitude * s);
+}
+
+// Пакетное вычисление sin/cos для массива фаз (векторизуемый цикл)
+void fastSinCosBatch(const double* x, double* s, double* c, size_t count,
+                     MathAccuracy accuracy = MathAccuracy::HIGH);
+
+// Быстрый atan2 и аргумент комплексного числа (замена std::arg)
+double fastAtan2(double y, double x, MathAccuracy accuracy = MathAccuracy::HIGH);
+
+inline double fastArg(const std::complex<double>& z, MathAccuracy accuracy = MathAccuracy::HIGH) {
+    return fastAtan2(z.imag(), z.real(), accuracy);
+}
+
+// Рекуррентный генератор фазора z[n+1] = z[n]·exp(i·increment).
+// Один комплексный множитель на отсчет вместо вызова exp; модуль
+// периодически нормируется, чтобы ошибка округления не накапливалась.
+class PhasorRotator {
+private:
+    double re_;
+    double im_;
+    double step_re_;
+    double step_im_;
+    unsigned steps_since_normalize_;
+
+public:
+    explicit PhasorRotator(double phase = 0.0, double phase_increment = 0.0);
+    
+    void reset(double phase, double phase_increment);
+    void setPhaseIncrement(double phase_increment);
+    
+    std::complex<double> value() const { return std::complex<double>(re_, im_); }
+    double real() const { return re_; }
+    double imag() const { return im_; }
+    
+    // Перейти к следующему отсчету
+    void advance() {
+        double re = re_ * step_re_ - im_ * step_im_;
+        im_ = re_ * step_im_ + im_ * step_re_;
+        re_ = re;
+        
+        if (++steps_since_normalize_ >= kNormalizeInterval) {
+            normalize();
+        }
+    }
+    
+    // Заполнить буферы n последовательными значениями и продвинуться на n отсчетов
+    void generate(double* re, double* im, size_t count);
+
+private:
+    static constexpr unsigned kNormalizeInterval = 64;
+    void normalize();
+};
+
+// Повернуть массив фазоров на общий угол: z[i] *= exp(i·angle)
+void rotatePhasors(std::complex<double>* phasors, size_t count, double angle,
+                   MathAccuracy accuracy = MathAccuracy::HIGH);
+
+} // namespace AnantaSound
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include <vector>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Диапазон полей в FieldArena: смещение и количество. Хранится смещение,
+// а не указатель, так как рост буфера переносит поля
+struct FieldRange {
+    size_t offset = 0;
+    size_t count = 0;
+
+    bool empty() const { return count == 0; }
+};
+
+// Кадровый буфер квантовых полей. Генераторы дописывают поля в buffer(),
+// reset() в начале тика делает буфер пустым, сохраняя память, поэтому после
+// первых кадров генерация полей не обращается к глобальному аллокатору.
+class FieldArena {
+private:
+    std::vector<QuantumSoundField> fields_;
+    size_t peak_size_ = 0;
+
+public:
+    explicit FieldArena(size_t initial_capacity = 0) {
+        fields_.reserve(initial_capacity);
+    }
+
+    // Начало кадра: поля и диапазоны прошлого кадра недействительны
+    void reset() {
+        if (fields_.size() > peak_size_) {
+            peak_size_ = fields_.size();
+        }
+        fields_.clear();
+    }
+
+    // Буфер для генераторов, дописывающих поля в конец
+    std::vector<QuantumSoundField>& buffer() { return fields_; }
+
+    // Диапазон полей, дописанных после отметки mark = size()
+    FieldRange since(size_t mark) const { return FieldRange{mark, fields_.size() - mark}; }
+
+    const QuantumSoundField* begin(const FieldRange& range) const { return fields_.data() + range.offset; }
+    const QuantumSoundField* end(const FieldRange& range) const { return begin(range) + range.count; }
+    const QuantumSoundField& operator[](size_t index) const { return fields_[index]; }
+
+    size_t size() const { return fields_.size(); }
+    size_t capacity() const { return fields_.capacity(); }
+    size_t getPeakSize() const { return peak_size_ > fields_.size() ? peak_size_ : fields_.size(); }
+};
+
+} // namespace AnantaSound
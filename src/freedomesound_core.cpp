@@ -1,21 +1,158 @@
 #include "anantasound_core.hpp"
+#include "thread_pool.hpp"
+#include "spatial_field_store.hpp"
+#include "room_response_cache.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <random>
 #include <chrono>
 #include <thread>
+#include <unordered_map>
 
 namespace AnantaSound {
 
 // InterferenceField implementation
+namespace {
+
+// Sources are processed in blocks so the per-block scratch arrays stay in L1
+constexpr size_t kSourceBlockSize = 256;
+
+// Independent accumulator lanes let the compiler vectorize the reduction
+constexpr size_t kAccumulatorLanes = 4;
+
+// Receivers evaluated against each source block while it is hot in cache
+constexpr size_t kReceiverTileSize = 16;
+
+// exp(i*pi/4) and exp(i*pi/6) applied by PHASE_MODULATED / QUANTUM_ENTANGLED fields
+const std::complex<double> kPhaseModulationFactor(M_SQRT1_2, M_SQRT1_2);
+const std::complex<double> kEntangledFieldFactor(0.86602540378443864676, 0.5);
+
+// Below this many source-receiver pairs a batch is evaluated on the calling thread
+constexpr size_t kParallelBatchThreshold = 1 << 15;
+
+// Smaller fields are always summed directly; the tree does not pay off
+constexpr size_t kMinSourcesForTree = 64;
+
+// Decoherence rate: 5% chance per 16 ms of simulated time, whatever the tick rate
+constexpr double kDecoherenceInterval = 0.016;
+constexpr double kDecoherenceProbability = 0.05;
+
+// Default fixed-step clock of AnantaSoundCore
+constexpr double kDefaultTickRate = 60.0;
+constexpr size_t kDefaultMaxCatchUpSteps = 5;
+
+// Sound fields handled per parallel chunk of the decoherence pass
+constexpr size_t kUpdateGrain = 4096;
+
+// Philox stream of the ingest noise; decoherence ticks use streams from 0 up
+constexpr uint64_t kNoiseStream = uint64_t(1) << 63;
+
+// QuantumAcousticProcessor tick period (~60 Hz) and ingest queue size limit
+constexpr std::chrono::milliseconds kProcessingTickInterval(16);
+constexpr size_t kMaxIncomingCapacity = size_t(1) << 16;
+
+// Mid-band reverberation time used for the Schroeder frequency
+constexpr double kSchroederReferenceFrequency = 500.0;
+
+// Modes above the highest evaluated frequency still shape the response below it
+constexpr double kModalResponseHeadroom = 1.5;
+
+// Time a source stays EXCITED before it decays to GROUND (s)
+constexpr double kExcitedStateLifetime = 0.1;
+
+// Default room-EQ grid: 1/24 octave from 20 Hz up to the Schroeder frequency
+constexpr double kEqLowestFrequency = 20.0;
+constexpr double kEqBandsPerOctave = 24.0;
+
+} // namespace
+
+void InterferenceField::SourceFieldStore::push(const QuantumSoundField& field) {
+    ++version;
+    x.push_back(0.0);
+    y.push_back(0.0);
+    z.push_back(0.0);
+    gain_re.push_back(0.0);
+    gain_im.push_back(0.0);
+    wavenumber.push_back(0.0);
+    update(x.size() - 1, field);
+}
+
+void InterferenceField::SourceFieldStore::update(size_t index, const QuantumSoundField& field) {
+    ++version;
+    const SphericalCoord& pos = field.position;
+    x[index] = pos.r * std::sin(pos.theta) * std::cos(pos.phi);
+    y[index] = pos.r * std::sin(pos.theta) * std::sin(pos.phi);
+    z[index] = pos.height;
+    
+    std::complex<double> gain = field.amplitude * getQuantumStateFactor(field.quantum_state);
+    gain_re[index] = gain.real();
+    gain_im[index] = gain.imag();
+    wavenumber[index] = 2.0 * M_PI * field.frequency / kSpeedOfSound;
+}
+
+void InterferenceField::SourceFieldStore::swapRemove(size_t index) {
+    ++version;
+    for (auto* column : {&x, &y, &z, &gain_re, &gain_im, &wavenumber}) {
+        (*column)[index] = column->back();
+        column->pop_back();
+    }
+}
+
 InterferenceField::InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius)
-    : type_(type), center_(center), field_radius_(radius) {
+    : type_(type), center_(center), approximation_tolerance_(0.0), source_tree_version_(UINT64_MAX),
+      field_radius_(radius), math_accuracy_(getDefaultMathAccuracy()) {
 }
 
-void InterferenceField::addSourceField(const QuantumSoundField& field) {
+InterferenceField::~InterferenceField() {
+    if (room_response_) {
+        releaseRoomTaps(batch_taps_);
+        releaseRoomTaps(point_taps_);
+    }
+}
+
+InterferenceField::SourceId InterferenceField::addSourceField(const QuantumSoundField& field) {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    source_fields_.push_back(field);
+    const SourceId id = source_fields_.insert(field);
+    source_store_.push(field);
+    excited_time_.push_back(0.0);
+    entanglement_.addNode(id.index);
+    return id;
+}
+
+bool InterferenceField::removeSourceField(SourceId id) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    const size_t index = source_fields_.denseIndexOf(id);
+    if (index == SIZE_MAX) {
+        return false;
+    }
+    
+    // The slot map and the SoA cache both move the last source into the hole
+    source_fields_.eraseDense(index);
+    source_store_.swapRemove(index);
+    excited_time_[index] = excited_time_.back();
+    excited_time_.pop_back();
+    entanglement_.removeNode(id.index);
+    return true;
+}
+
+size_t InterferenceField::getSourceCount() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return source_fields_.size();
+}
+
+InterferenceField::SourceId InterferenceField::getSourceId(size_t index) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return index < source_fields_.size() ? source_fields_.handleAt(index) : SourceId{};
+}
+
+bool InterferenceField::getSourceField(SourceId id, QuantumSoundField& field) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    const QuantumSoundField* stored = source_fields_.get(id);
+    if (!stored) {
+        return false;
+    }
+    field = *stored;
+    return true;
 }
 
 std::complex<double> InterferenceField::calculateInterference(const SphericalCoord& position, double time) const {
@@ -25,48 +162,267 @@ std::complex<double> InterferenceField::calculateInterference(const SphericalCoo
         return std::complex<double>(0.0, 0.0);
     }
     
-    std::complex<double> total_field(0.0, 0.0);
+    double x = position.r * std::sin(position.theta) * std::cos(position.phi);
+    double y = position.r * std::sin(position.theta) * std::sin(position.phi);
+    double z = position.height;
     
-    for (const auto& field : source_fields_) {
-        // Calculate distance from source to position
-        double dx = position.r * sin(position.theta) * cos(position.phi) - 
-                   field.position.r * sin(field.position.theta) * cos(field.position.phi);
-        double dy = position.r * sin(position.theta) * sin(position.phi) - 
-                   field.position.r * sin(field.position.theta) * sin(field.position.phi);
-        double dz = position.height - field.position.height;
-        
-        double distance = std::sqrt(dx*dx + dy*dy + dz*dz);
-        
-        // Calculate phase delay
-        double phase_delay = 2.0 * M_PI * field.frequency * distance / 343.0; // 343 m/s is speed of sound
-        
-        // Apply quantum state effects
-        std::complex<double> quantum_factor(1.0, 0.0);
-        switch (field.quantum_state) {
-            case QuantumSoundState::COHERENT:
-                quantum_factor = std::complex<double>(1.0, 0.0);
-                break;
-            case QuantumSoundState::SUPERPOSITION:
-                quantum_factor = std::complex<double>(0.707, 0.707);
-                break;
-            case QuantumSoundState::ENTANGLED:
-                quantum_factor = std::complex<double>(0.5, 0.866);
-                break;
-            case QuantumSoundState::COLLAPSED:
-                quantum_factor = std::complex<double>(0.0, 1.0);
-                break;
-            default:
-                quantum_factor = std::complex<double>(1.0, 0.0);
-                break;
+    std::complex<double> total_field;
+    if (room_response_) {
+        // A receiver that stays put reuses its taps like a batch does
+        refreshRoomTaps(point_taps_, &x, &y, &z, 1);
+        const bool retained = reserveRoomTaps(point_taps_);
+        total_field = accumulateRoomTaps(point_taps_, 0, x, y, z);
+        if (!retained) {
+            releaseRoomTaps(point_taps_);
         }
+    } else if (useSourceTree()) {
+        total_field = source_tree_.evaluate(x, y, z, approximation_tolerance_, math_accuracy_);
+    } else {
+        accumulateReceiverTile(&x, &y, &z, 1, &total_field);
+    }
+    
+    return applyInterferenceType(total_field, time);
+}
+
+std::vector<std::complex<double>> InterferenceField::calculateInterferenceBatch(const std::vector<SphericalCoord>& positions,
+                                                                                double time) const {
+    std::vector<std::complex<double>> result(positions.size(), std::complex<double>(0.0, 0.0));
+    
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    
+    if (source_fields_.empty() || positions.empty()) {
+        return result;
+    }
+    
+    // Receiver positions are converted once per batch, not once per source
+    const size_t receiver_count = positions.size();
+    std::vector<double> x(receiver_count), y(receiver_count), z(receiver_count);
+    for (size_t i = 0; i < receiver_count; ++i) {
+        const SphericalCoord& p = positions[i];
+        x[i] = p.r * std::sin(p.theta) * std::cos(p.phi);
+        y[i] = p.r * std::sin(p.theta) * std::sin(p.phi);
+        z[i] = p.height;
+    }
+    
+    // The tree and the room taps are refreshed here, before any worker reads them
+    const bool use_tree = !room_response_ && useSourceTree();
+    bool retained = true;
+    if (room_response_) {
+        refreshRoomTaps(batch_taps_, x.data(), y.data(), z.data(), receiver_count);
+        retained = reserveRoomTaps(batch_taps_);
+    }
+    
+    auto evaluate_tiles = [&](size_t begin, size_t end) {
+        if (room_response_) {
+            for (size_t i = begin; i < end; ++i) {
+                result[i] = applyInterferenceType(accumulateRoomTaps(batch_taps_, i, x[i], y[i], z[i]), time);
+            }
+            return;
+        }
+        if (use_tree) {
+            for (size_t i = begin; i < end; ++i) {
+                result[i] = applyInterferenceType(
+                    source_tree_.evaluate(x[i], y[i], z[i], approximation_tolerance_, math_accuracy_), time);
+            }
+            return;
+        }
+        for (size_t tile = begin; tile < end; tile += kReceiverTileSize) {
+            size_t n = std::min(kReceiverTileSize, end - tile);
+            accumulateReceiverTile(&x[tile], &y[tile], &z[tile], n, &result[tile]);
+            for (size_t i = tile; i < tile + n; ++i) {
+                result[i] = applyInterferenceType(result[i], time);
+            }
+        }
+    };
+    
+    // field_mutex_ stays held by this thread while the pool reads the source store
+    if (receiver_count * source_store_.size() < kParallelBatchThreshold) {
+        evaluate_tiles(0, receiver_count);
+    } else {
+        ThreadPool::shared().parallelFor(receiver_count, kReceiverTileSize * 4, evaluate_tiles);
+    }
+    
+    if (!retained) {
+        releaseRoomTaps(batch_taps_);
+    }
+    return result;
+}
+
+void InterferenceField::accumulateReceiverTile(const double* x, const double* y, const double* z,
+                                               size_t receiver_count, std::complex<double>* out) const {
+    const size_t count = source_store_.size();
+    const double* src_x = source_store_.x.data();
+    const double* src_y = source_store_.y.data();
+    const double* src_z = source_store_.z.data();
+    const double* gain_re = source_store_.gain_re.data();
+    const double* gain_im = source_store_.gain_im.data();
+    const double* wavenumber = source_store_.wavenumber.data();
+    
+    double phase[kSourceBlockSize];
+    double cos_phase[kSourceBlockSize];
+    double sin_phase[kSourceBlockSize];
+    
+    double acc_re[kReceiverTileSize][kAccumulatorLanes] = {};
+    double acc_im[kReceiverTileSize][kAccumulatorLanes] = {};
+    
+    for (size_t begin = 0; begin < count; begin += kSourceBlockSize) {
+        const size_t n = std::min(kSourceBlockSize, count - begin);
+        const double* gr = gain_re + begin;
+        const double* gi = gain_im + begin;
         
-        // Calculate field contribution
-        std::complex<double> field_contribution = field.amplitude * quantum_factor * 
-            std::exp(std::complex<double>(0.0, -phase_delay));
-        
-        total_field += field_contribution;
+        for (size_t r = 0; r < receiver_count; ++r) {
+            // Phase delay k * |r - r_src| for the whole block
+            for (size_t j = 0; j < n; ++j) {
+                double dx = x[r] - src_x[begin + j];
+                double dy = y[r] - src_y[begin + j];
+                double dz = z[r] - src_z[begin + j];
+                phase[j] = wavenumber[begin + j] * std::sqrt(dx * dx + dy * dy + dz * dz);
+            }
+            
+            fastSinCosBatch(phase, sin_phase, cos_phase, n, math_accuracy_);
+            
+            // gain * exp(-i * phase), accumulated lane-wise
+            double* lane_re = acc_re[r];
+            double* lane_im = acc_im[r];
+            size_t j = 0;
+            for (; j + kAccumulatorLanes <= n; j += kAccumulatorLanes) {
+                for (size_t l = 0; l < kAccumulatorLanes; ++l) {
+                    lane_re[l] += gr[j + l] * cos_phase[j + l] + gi[j + l] * sin_phase[j + l];
+                    lane_im[l] += gi[j + l] * cos_phase[j + l] - gr[j + l] * sin_phase[j + l];
+                }
+            }
+            for (; j < n; ++j) {
+                lane_re[0] += gr[j] * cos_phase[j] + gi[j] * sin_phase[j];
+                lane_im[0] += gi[j] * cos_phase[j] - gr[j] * sin_phase[j];
+            }
+        }
     }
     
+    for (size_t r = 0; r < receiver_count; ++r) {
+        double total_re = 0.0;
+        double total_im = 0.0;
+        for (size_t l = 0; l < kAccumulatorLanes; ++l) {
+            total_re += acc_re[r][l];
+            total_im += acc_im[r][l];
+        }
+        out[r] = std::complex<double>(total_re, total_im);
+    }
+}
+
+void InterferenceField::refreshRoomTaps(RoomTapSet& taps, const double* x, const double* y, const double* z,
+                                        size_t receiver_count) const {
+    // A different receiver set invalidates every row
+    std::vector<double>& receivers = taps.receivers;
+    bool same_receivers = receivers.size() == 3 * receiver_count;
+    for (size_t i = 0; same_receivers && i < receiver_count; ++i) {
+        same_receivers = receivers[3 * i] == x[i] && receivers[3 * i + 1] == y[i] && receivers[3 * i + 2] == z[i];
+    }
+    if (!same_receivers) {
+        receivers.resize(3 * receiver_count);
+        for (size_t i = 0; i < receiver_count; ++i) {
+            receivers[3 * i] = x[i];
+            receivers[3 * i + 1] = y[i];
+            receivers[3 * i + 2] = z[i];
+        }
+        for (RoomTapRow& row : taps.rows) {
+            row.valid = false;
+        }
+    }
+    
+    // Rows follow dense source indices; a row is reused while its source stays put
+    const size_t count = source_store_.size();
+    taps.rows.resize(count);
+    std::vector<size_t> stale;
+    for (size_t j = 0; j < count; ++j) {
+        const RoomTapRow& row = taps.rows[j];
+        if (!row.valid || row.x != source_store_.x[j] || row.y != source_store_.y[j] || row.z != source_store_.z[j]) {
+            stale.push_back(j);
+        }
+    }
+    if (stale.empty()) {
+        return;
+    }
+    
+    const double speed_of_sound = room_response_->getSpeedOfSound();
+    auto refresh_rows = [&](size_t begin, size_t end) {
+        RoomTransfer transfer;
+        for (size_t s = begin; s < end; ++s) {
+            const size_t j = stale[s];
+            RoomTapRow& row = taps.rows[j];
+            const double source[3] = {source_store_.x[j], source_store_.y[j], source_store_.z[j]};
+            row.offsets.clear();
+            row.length.clear();
+            row.gain.clear();
+            for (size_t i = 0; i < receiver_count; ++i) {
+                const double receiver[3] = {x[i], y[i], z[i]};
+                room_response_->lookup(source, receiver, transfer);
+                row.offsets.push_back(static_cast<uint32_t>(row.length.size()));
+                const double inv_direct_gain = 1.0 / transfer.gain;
+                for (const ReflectionTap& tap : transfer.taps) {
+                    row.length.push_back(speed_of_sound * tap.delay);
+                    row.gain.push_back(tap.gain * inv_direct_gain);
+                }
+            }
+            row.offsets.push_back(static_cast<uint32_t>(row.length.size()));
+            row.x = source[0];
+            row.y = source[1];
+            row.z = source[2];
+            row.valid = true;
+        }
+    };
+    
+    if (stale.size() * receiver_count < kParallelBatchThreshold) {
+        refresh_rows(0, stale.size());
+    } else {
+        ThreadPool::shared().parallelFor(stale.size(), 1, refresh_rows);
+    }
+}
+
+bool InterferenceField::reserveRoomTaps(RoomTapSet& taps) const {
+    size_t bytes = taps.receivers.capacity() * sizeof(double) + taps.rows.capacity() * sizeof(RoomTapRow);
+    for (const RoomTapRow& row : taps.rows) {
+        bytes += row.offsets.capacity() * sizeof(uint32_t) +
+                 (row.length.capacity() + row.gain.capacity()) * sizeof(double);
+    }
+    
+    if (bytes < taps.reserved_bytes) {
+        room_response_->releaseMemory(taps.reserved_bytes - bytes);
+    } else if (bytes > taps.reserved_bytes && !room_response_->reserveMemory(bytes - taps.reserved_bytes)) {
+        return false;
+    }
+    taps.reserved_bytes = bytes;
+    return true;
+}
+
+void InterferenceField::releaseRoomTaps(RoomTapSet& taps) const {
+    room_response_->releaseMemory(taps.reserved_bytes);
+    taps = RoomTapSet();
+}
+
+std::complex<double> InterferenceField::accumulateRoomTaps(const RoomTapSet& taps, size_t receiver,
+                                                          double x, double y, double z) const {
+    std::complex<double> total(0.0, 0.0);
+    
+    for (size_t j = 0; j < source_store_.size(); ++j) {
+        const RoomTapRow& row = taps.rows[j];
+        const double k = source_store_.wavenumber[j];
+        double dx = x - source_store_.x[j];
+        double dy = y - source_store_.y[j];
+        double dz = z - source_store_.z[j];
+        double s, c;
+        fastSinCos(k * std::sqrt(dx * dx + dy * dy + dz * dz), s, c, math_accuracy_);
+        std::complex<double> path(c, -s);
+        
+        for (uint32_t t = row.offsets[receiver]; t < row.offsets[receiver + 1]; ++t) {
+            fastSinCos(k * row.length[t], s, c, math_accuracy_);
+            path += row.gain[t] * std::complex<double>(c, -s);
+        }
+        total += std::complex<double>(source_store_.gain_re[j], source_store_.gain_im[j]) * path;
+    }
+    return total;
+}
+
+std::complex<double> InterferenceField::applyInterferenceType(const std::complex<double>& total_field, double time) const {
     // Apply interference type effects
     switch (type_) {
         case InterferenceFieldType::CONSTRUCTIVE:
@@ -74,11 +430,11 @@ std::complex<double> InterferenceField::calculateInterference(const SphericalCoo
         case InterferenceFieldType::DESTRUCTIVE:
             return -total_field;
         case InterferenceFieldType::PHASE_MODULATED:
-            return total_field * std::exp(std::complex<double>(0.0, M_PI / 4.0));
+            return total_field * kPhaseModulationFactor;
         case InterferenceFieldType::AMPLITUDE_MODULATED:
-            return total_field * (1.0 + 0.5 * std::sin(2.0 * M_PI * 10.0 * time));
+            return total_field * (1.0 + 0.5 * fastSin(2.0 * M_PI * 10.0 * time, math_accuracy_));
         case InterferenceFieldType::QUANTUM_ENTANGLED:
-            return total_field * std::complex<double>(std::cos(M_PI / 6.0), std::sin(M_PI / 6.0));
+            return total_field * kEntangledFieldFactor;
         default:
             return total_field;
     }
@@ -119,13 +475,17 @@ QuantumSoundField InterferenceField::quantumSuperposition(const std::vector<Quan
 void InterferenceField::updateQuantumState(double dt) {
     std::lock_guard<std::mutex> lock(field_mutex_);
     
-    for (auto& field : source_fields_) {
+    for (size_t i = 0; i < source_fields_.size(); ++i) {
+        auto& field = source_fields_[i];
+        
         // Simple quantum state evolution
         switch (field.quantum_state) {
             case QuantumSoundState::EXCITED:
-                // Decay to ground state
-                if (dt > 0.1) {
-                    field.quantum_state = QuantumSoundState::GROUND;
+                // Decay to ground state once the source has been excited
+                // long enough, however the time arrives in steps
+                excited_time_[i] += dt;
+                if (excited_time_[i] >= kExcitedStateLifetime) {
+                    setSourceStateLocked(i, QuantumSoundState::GROUND);
                 }
                 break;
             case QuantumSoundState::SUPERPOSITION:
@@ -144,77 +504,348 @@ void InterferenceField::createQuantumEntanglement(size_t field1_idx, size_t fiel
     std::lock_guard<std::mutex> lock(field_mutex_);
     
     if (field1_idx < source_fields_.size() && field2_idx < source_fields_.size()) {
-        source_fields_[field1_idx].quantum_state = QuantumSoundState::ENTANGLED;
-        source_fields_[field2_idx].quantum_state = QuantumSoundState::ENTANGLED;
-        entangled_pairs_.emplace_back(field1_idx, field2_idx);
+        entangleLocked(source_fields_.handleAt(field1_idx), source_fields_.handleAt(field2_idx));
+    }
+}
+
+bool InterferenceField::entangleSources(SourceId first, SourceId second) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    
+    if (!source_fields_.contains(first) || !source_fields_.contains(second) || first == second) {
+        return false;
+    }
+    entangleLocked(first, second);
+    return true;
+}
+
+void InterferenceField::entangleLocked(SourceId first, SourceId second) {
+    for (SourceId id : {first, second}) {
+        setSourceStateLocked(source_fields_.denseIndexOf(id), QuantumSoundState::ENTANGLED);
+    }
+    entanglement_.addEdge(first.index, second.index);
+}
+
+void InterferenceField::setSourceStateLocked(size_t index, QuantumSoundState state) {
+    if (source_fields_[index].quantum_state != state) {
+        excited_time_[index] = 0.0;
     }
+    source_fields_[index].quantum_state = state;
+    source_store_.update(index, source_fields_[index]);
 }
 
 size_t InterferenceField::getEntangledPairsCount() const {
     std::lock_guard<std::mutex> lock(field_mutex_);
-    return entangled_pairs_.size();
+    return entanglement_.getEdgeCount();
+}
+
+InterferenceField::SourceId InterferenceField::getEntanglementCluster(SourceId id) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    if (!source_fields_.contains(id)) {
+        return SourceId{};
+    }
+    return source_fields_.handleOfSlot(entanglement_.clusterOf(id.index));
+}
+
+std::vector<InterferenceField::SourceId> InterferenceField::getEntanglementClusterMembers(SourceId id) const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    std::vector<SourceId> members;
+    if (!source_fields_.contains(id)) {
+        return members;
+    }
+    for (EntanglementGraph::NodeId slot : entanglement_.clusterMembers(id.index)) {
+        members.push_back(source_fields_.handleOfSlot(slot));
+    }
+    return members;
+}
+
+void InterferenceField::setClusterQuantumState(SourceId id, QuantumSoundState state) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    if (!source_fields_.contains(id)) {
+        return;
+    }
+    for (EntanglementGraph::NodeId slot : entanglement_.clusterMembers(id.index)) {
+        setSourceStateLocked(source_fields_.denseIndexOf(source_fields_.handleOfSlot(slot)), state);
+    }
+}
+
+bool InterferenceField::useSourceTree() const {
+    if (approximation_tolerance_ <= 0.0 || source_store_.size() < kMinSourcesForTree) {
+        return false;
+    }
+    if (source_tree_version_ != source_store_.version) {
+        source_tree_.build(source_store_.x.data(), source_store_.y.data(), source_store_.z.data(),
+                           source_store_.gain_re.data(), source_store_.gain_im.data(),
+                           source_store_.wavenumber.data(), source_store_.size());
+        source_tree_version_ = source_store_.version;
+    }
+    return true;
+}
+
+void InterferenceField::setApproximationTolerance(double tolerance) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    approximation_tolerance_ = std::clamp(tolerance, 0.0, 1.0);
+}
+
+double InterferenceField::getApproximationTolerance() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return approximation_tolerance_;
+}
+
+void InterferenceField::setRoomResponseCache(std::shared_ptr<RoomResponseCache> cache) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    if (room_response_) {
+        releaseRoomTaps(batch_taps_);
+        releaseRoomTaps(point_taps_);
+    }
+    room_response_ = std::move(cache);
+}
+
+std::shared_ptr<RoomResponseCache> InterferenceField::getRoomResponseCache() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return room_response_;
+}
+
+void InterferenceField::setMathAccuracy(MathAccuracy accuracy) {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    math_accuracy_ = accuracy;
+}
+
+MathAccuracy InterferenceField::getMathAccuracy() const {
+    std::lock_guard<std::mutex> lock(field_mutex_);
+    return math_accuracy_;
 }
 
 // DomeAcousticResonator implementation
 DomeAcousticResonator::DomeAcousticResonator(double radius, double height)
-    : dome_radius_(radius), dome_height_(height) {
-    // Calculate fundamental resonant frequencies
+    : dome_radius_(radius)
+    , dome_height_(height)
+    , shape_model_(DomeShapeModel::CYLINDER)
+    , has_material_(false)
+    , reverb_formula_(ReverbFormula::SABINE) {
+    // Calculate resonant frequencies of the modal region
+    updateResonantFrequencies();
+}
+
+void DomeAcousticResonator::updateResonantFrequencies() {
+    // The Schroeder cutoff depends on T60 at 500 Hz, so geometry, material
+    // and formula changes all move the modal region
     resonant_frequencies_ = calculateEigenFrequencies();
 }
 
 std::vector<double> DomeAcousticResonator::calculateEigenFrequencies() const {
+    return calculateEigenFrequencies(getSchroederFrequency());
+}
+
+std::vector<double> DomeAcousticResonator::calculateEigenFrequencies(double max_frequency) const {
+    DomeModeList modes = getModes(max_frequency);
     std::vector<double> frequencies;
-    
-    // Fundamental frequency (0,1) mode
-    double f01 = 343.0 / (2.0 * M_PI) * std::sqrt(std::pow(1.84 / dome_radius_, 2) + 
-                                                   std::pow(M_PI / dome_height_, 2));
-    frequencies.push_back(f01);
-    
-    // Higher order modes
-    for (int n = 1; n <= 5; ++n) {
-        for (int m = 0; m <= 3; ++m) {
-            double jnm = 0.0;
-            if (n == 1 && m == 0) jnm = 3.83;
-            else if (n == 2 && m == 0) jnm = 7.02;
-            else if (n == 0 && m == 1) jnm = 1.84;
-            else if (n == 1 && m == 1) jnm = 5.33;
-            else continue;
-            
-            double freq = 343.0 / (2.0 * M_PI) * std::sqrt(std::pow(jnm / dome_radius_, 2) + 
-                                                           std::pow(m * M_PI / dome_height_, 2));
-            frequencies.push_back(freq);
-        }
+    frequencies.reserve(modes->size());
+    for (const DomeMode& mode : *modes) {
+        frequencies.push_back(mode.frequency);
     }
-    
-    std::sort(frequencies.begin(), frequencies.end());
     return frequencies;
 }
 
+DomeModeList DomeAcousticResonator::getModes(double max_frequency) const {
+    return DomeModalSolver::getModes(shape_model_, dome_radius_, dome_height_, max_frequency);
+}
+
+void DomeAcousticResonator::setShapeModel(DomeShapeModel model) {
+    shape_model_ = model;
+    updateResonantFrequencies();
+}
+
+double DomeAcousticResonator::getVolume() const {
+    if (shape_model_ == DomeShapeModel::SPHERE) {
+        return 4.0 / 3.0 * M_PI * dome_radius_ * dome_radius_ * dome_radius_;
+    }
+    if (shape_model_ == DomeShapeModel::HEMISPHERE) {
+        return 2.0 / 3.0 * M_PI * dome_radius_ * dome_radius_ * dome_radius_;
+    }
+    return M_PI * dome_radius_ * dome_radius_ * dome_height_;
+}
+
+double DomeAcousticResonator::getSurfaceArea() const {
+    if (shape_model_ == DomeShapeModel::SPHERE) {
+        return 4.0 * M_PI * dome_radius_ * dome_radius_;
+    }
+    if (shape_model_ == DomeShapeModel::HEMISPHERE) {
+        // Shell plus floor
+        return 3.0 * M_PI * dome_radius_ * dome_radius_;
+    }
+    return 2.0 * M_PI * dome_radius_ * (dome_radius_ + dome_height_);
+}
+
+double DomeAcousticResonator::getSchroederFrequency() const {
+    const double volume = getVolume();
+    if (volume <= 0.0) {
+        return 0.0;
+    }
+    return 2000.0 * std::sqrt(calculateReverbTime(kSchroederReferenceFrequency) / volume);
+}
+
 void DomeAcousticResonator::setMaterialProperties(const std::map<double, double>& properties) {
-    acoustic_properties_ = properties;
+    property_frequencies_.clear();
+    property_multipliers_.clear();
+    for (const auto& property : properties) {
+        if (property.first > 0.0) {
+            property_frequencies_.push_back(property.first);
+            property_multipliers_.push_back(property.second);
+        }
+    }
+    updateResonantFrequencies();
 }
 
-double DomeAcousticResonator::calculateReverbTime(double frequency) const {
+void DomeAcousticResonator::setMaterial(const AcousticMaterial& material) {
+    material_ = material;
+    has_material_ = true;
+    updateResonantFrequencies();
+}
+
+void DomeAcousticResonator::setReverbFormula(ReverbFormula formula) {
+    reverb_formula_ = formula;
+    updateResonantFrequencies();
+}
+
+double DomeAcousticResonator::empiricalReverbTime() const {
     // Default reverb time calculation
-    double rt60 = 0.161 * dome_radius_ * dome_height_ / (0.1 * dome_radius_ + 0.1 * dome_height_);
+    return 0.161 * dome_radius_ * dome_height_ / (0.1 * dome_radius_ + 0.1 * dome_height_);
+}
+
+double DomeAcousticResonator::calculateReverbTime(double frequency) const {
+    double rt60;
+    if (has_material_) {
+        rt60 = material_.reverbTime(frequency, getVolume(), getSurfaceArea(), reverb_formula_);
+    } else {
+        rt60 = empiricalReverbTime();
+    }
     
     // Adjust based on material properties if available
-    auto it = acoustic_properties_.find(frequency);
-    if (it != acoustic_properties_.end()) {
-        rt60 *= it->second;
+    if (!property_frequencies_.empty()) {
+        rt60 *= interpolateLogFrequency(property_frequencies_.data(), property_multipliers_.data(),
+                                        property_frequencies_.size(), frequency);
     }
     
     return rt60;
 }
 
+std::vector<double> DomeAcousticResonator::calculateReverbTimes(const std::vector<double>& frequencies) const {
+    std::vector<double> reverb_times(frequencies.size());
+    if (has_material_) {
+        material_.reverbTimes(frequencies.data(), reverb_times.data(), frequencies.size(),
+                              getVolume(), getSurfaceArea(), reverb_formula_);
+    } else {
+        std::fill(reverb_times.begin(), reverb_times.end(), empiricalReverbTime());
+    }
+    
+    if (!property_frequencies_.empty()) {
+        for (size_t i = 0; i < frequencies.size(); ++i) {
+            reverb_times[i] *= interpolateLogFrequency(property_frequencies_.data(), property_multipliers_.data(),
+                                                       property_frequencies_.size(), frequencies[i]);
+        }
+    }
+    return reverb_times;
+}
+
+std::vector<double> DomeAcousticResonator::calculateModalResponse(const std::vector<double>& frequencies) const {
+    std::vector<double> response(frequencies.size(), 0.0);
+    if (frequencies.empty()) {
+        return response;
+    }
+    
+    const double max_frequency = *std::max_element(frequencies.begin(), frequencies.end());
+    DomeModeList modes = getModes(kModalResponseHeadroom * max_frequency);
+    if (modes->empty()) {
+        return response;
+    }
+    
+    // Angular frequency, decay rate and degeneracy of every mode
+    const size_t mode_count = modes->size();
+    std::vector<double> mode_frequencies(mode_count);
+    for (size_t k = 0; k < mode_count; ++k) {
+        mode_frequencies[k] = (*modes)[k].frequency;
+    }
+    std::vector<double> decay = calculateReverbTimes(mode_frequencies);
+    std::vector<double> omega_sq(mode_count);
+    std::vector<double> weight(mode_count);
+    for (size_t k = 0; k < mode_count; ++k) {
+        const double omega = 2.0 * M_PI * mode_frequencies[k];
+        omega_sq[k] = omega * omega;
+        decay[k] = 3.0 * std::log(10.0) / std::max(decay[k], 1e-3);
+        weight[k] = (*modes)[k].multiplicity;
+    }
+    
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        const double omega = 2.0 * M_PI * frequencies[i];
+        const double omega2 = omega * omega;
+        double power = 0.0;
+        for (size_t k = 0; k < mode_count; ++k) {
+            const double detune = omega_sq[k] - omega2;
+            const double damping = 2.0 * decay[k] * omega;
+            power += weight[k] / (detune * detune + damping * damping);
+        }
+        response[i] = 10.0 * std::log10(std::max(power, 1e-300));
+    }
+    return response;
+}
+
+void DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>& target_frequencies) {
+    std::vector<double> frequencies = target_frequencies;
+    if (frequencies.empty()) {
+        const double upper = std::max(getSchroederFrequency(), 2.0 * kEqLowestFrequency);
+        for (double f = kEqLowestFrequency; f <= upper; f *= std::exp2(1.0 / kEqBandsPerOctave)) {
+            frequencies.push_back(f);
+        }
+    }
+    optimizeFrequencyResponse(frequencies, std::vector<double>(frequencies.size(), 0.0));
+}
+
+void DomeAcousticResonator::optimizeFrequencyResponse(const std::vector<double>& frequencies,
+                                                      const std::vector<double>& target_db) {
+    const size_t count = std::min(frequencies.size(), target_db.size());
+    std::vector<double> grid(frequencies.begin(), frequencies.begin() + count);
+    std::vector<double> response = calculateModalResponse(grid);
+    
+    // Deviation from the target, level-matched so only the shape is corrected
+    std::vector<double> deviation(count);
+    double mean = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        deviation[i] = response[i] - target_db[i];
+        mean += deviation[i];
+    }
+    mean /= std::max<size_t>(count, 1);
+    for (double& d : deviation) {
+        d -= mean;
+    }
+    
+    correction_ = fitParametricEq(grid, deviation, eq_settings_, correction_.bands);
+}
+
+BiquadCascade DomeAcousticResonator::getCorrectionFilters() const {
+    return BiquadCascade::fromParametricBands(correction_.bands, eq_settings_.sample_rate);
+}
+
 // AnantaSoundCore implementation
 AnantaSoundCore::AnantaSoundCore(double radius, double height)
     : dome_radius_(radius)
     , dome_height_(height)
     , quantum_uncertainty_(0.1)
-    , is_initialized_(false) {
+    , is_initialized_(false)
+    , snapshot_epoch_(0)
+    , random_seed_(nextInstanceSeed())
+    , update_tick_(0)
+    , tick_rate_(kDefaultTickRate)
+    , max_catch_up_steps_(kDefaultMaxCatchUpSteps)
+    , time_accumulator_(0.0)
+    , simulation_time_(0.0)
+    , fields_changed_since_tick_(false) {
     
+    noise_stream_.reseed(random_seed_, kNoiseStream);
     dome_resonator_ = std::make_unique<DomeAcousticResonator>(radius, height);
+    sound_fields_ = std::make_unique<SpatialFieldStore>();
+    auto initial = std::make_shared<CoreSnapshot>();
+    initial->fields = std::make_shared<const std::vector<QuantumSoundField>>();
+    std::atomic_store(&snapshot_, std::shared_ptr<const CoreSnapshot>(std::move(initial)));
 }
 
 AnantaSoundCore::~AnantaSoundCore() {
@@ -236,7 +867,9 @@ bool AnantaSoundCore::initialize() {
             dome_resonator_->setMaterialProperties(properties);
         }
         
+        std::lock_guard<std::mutex> lock(core_mutex_);
         is_initialized_ = true;
+        publishSnapshot();
         return true;
         
     } catch (const std::exception& e) {
@@ -254,19 +887,33 @@ void AnantaSoundCore::shutdown() {
     {
         std::lock_guard<std::mutex> lock(core_mutex_);
         interference_fields_.clear();
-        sound_fields_.clear();
+        sound_fields_->clear();
+        previous_tick_fields_.reset();
+        last_tick_fields_.reset();
+        time_accumulator_ = 0.0;
+        fields_changed_since_tick_ = true;
+        publishSnapshot();
     }
     
     is_initialized_ = false;
 }
 
-void AnantaSoundCore::addInterferenceField(std::unique_ptr<InterferenceField> field) {
+AnantaSoundCore::InterferenceFieldHandle AnantaSoundCore::addInterferenceField(std::unique_ptr<InterferenceField> field) {
     if (!is_initialized_) {
-        return;
+        return InterferenceFieldHandle{};
     }
     
     std::lock_guard<std::mutex> lock(core_mutex_);
-    interference_fields_.push_back(std::move(field));
+    return interference_fields_.insert(std::move(field));
+}
+
+bool AnantaSoundCore::removeInterferenceField(InterferenceFieldHandle handle) {
+    if (!is_initialized_) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return interference_fields_.erase(handle);
 }
 
 void AnantaSoundCore::removeInterferenceField(size_t field_index) {
@@ -274,12 +921,24 @@ void AnantaSoundCore::removeInterferenceField(size_t field_index) {
         return;
     }
     
+    // Index-based callers rely on the order of the remaining fields
     std::lock_guard<std::mutex> lock(core_mutex_);
     if (field_index < interference_fields_.size()) {
-        interference_fields_.erase(interference_fields_.begin() + field_index);
+        interference_fields_.eraseDenseOrdered(field_index);
     }
 }
 
+InterferenceField* AnantaSoundCore::getInterferenceField(InterferenceFieldHandle handle) const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    const auto* field = interference_fields_.get(handle);
+    return field ? field->get() : nullptr;
+}
+
+size_t AnantaSoundCore::getInterferenceFieldCount() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return interference_fields_.size();
+}
+
 QuantumSoundField AnantaSoundCore::createQuantumSoundField(double frequency, 
                                                           const SphericalCoord& position,
                                                           QuantumSoundState state) {
@@ -295,27 +954,45 @@ QuantumSoundField AnantaSoundCore::createQuantumSoundField(double frequency,
 }
 
 void AnantaSoundCore::processSoundField(const QuantumSoundField& input_field) {
-    if (!is_initialized_) {
+    processSoundFields(&input_field, 1);
+}
+
+void AnantaSoundCore::processSoundFields(const std::vector<QuantumSoundField>& input_fields) {
+    processSoundFields(input_fields.data(), input_fields.size());
+}
+
+void AnantaSoundCore::processSoundFields(const QuantumSoundField* input_fields, size_t count) {
+    if (!is_initialized_ || count == 0) {
         return;
     }
     
     std::lock_guard<std::mutex> lock(core_mutex_);
+    fields_changed_since_tick_ = true;
     
-    // Store the field
-    sound_fields_[input_field.position] = input_field;
+    sound_fields_->reserve(sound_fields_->size() + count);
     
     // Apply quantum uncertainty
-    if (quantum_uncertainty_ > 0.0) {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::normal_distribution<double> dist(0.0, quantum_uncertainty_);
+    const bool add_noise = quantum_uncertainty_ > 0.0;
+    if (add_noise) {
+        generateQuantumNoise(count);
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        // Store the field
+        QuantumSoundField& stored = sound_fields_->insertOrAssign(input_fields[i]);
         
-        // Add quantum noise to amplitude
-        double noise = dist(gen);
-        sound_fields_[input_field.position].amplitude += std::complex<double>(noise, noise);
+        if (add_noise) {
+            // Add quantum noise to amplitude
+            stored.amplitude += std::complex<double>(noise_buffer_[i], noise_buffer_[i]);
+        }
     }
 }
 
+void AnantaSoundCore::generateQuantumNoise(size_t count) {
+    noise_buffer_.resize(count);
+    noise_stream_.fillNormal(noise_buffer_.data(), count, 0.0, quantum_uncertainty_);
+}
+
 std::vector<QuantumSoundField> AnantaSoundCore::getOutputFields() const {
     if (!is_initialized_) {
         return {};
@@ -323,14 +1000,26 @@ std::vector<QuantumSoundField> AnantaSoundCore::getOutputFields() const {
     
     std::lock_guard<std::mutex> lock(core_mutex_);
     
-    std::vector<QuantumSoundField> output_fields;
-    output_fields.reserve(sound_fields_.size());
+    return sound_fields_->values();
+}
+
+std::vector<QuantumSoundField> AnantaSoundCore::getFieldsNear(const SphericalCoord& position, double radius) const {
+    if (!is_initialized_) {
+        return {};
+    }
+    
+    std::lock_guard<std::mutex> lock(core_mutex_);
     
-    for (const auto& [pos, field] : sound_fields_) {
-        output_fields.push_back(field);
+    std::vector<size_t> indices;
+    sound_fields_->queryRadius(position, radius, indices);
+    
+    std::vector<QuantumSoundField> near_fields;
+    near_fields.reserve(indices.size());
+    for (size_t index : indices) {
+        near_fields.push_back((*sound_fields_)[index]);
     }
     
-    return output_fields;
+    return near_fields;
 }
 
 void AnantaSoundCore::update(double dt) {
@@ -338,47 +1027,176 @@ void AnantaSoundCore::update(double dt) {
         return;
     }
     
-    // Update interference fields
-    for (auto& field : interference_fields_) {
-        if (field) {
-            field->updateQuantumState(dt);
+    {
+        // Holding the core lock for the whole pass keeps ingest and removal
+        // out while workers touch the fields.
+        std::lock_guard<std::mutex> lock(core_mutex_);
+        
+        // Fixed-step clock: consume whole steps from the accumulator and keep
+        // the remainder, so the simulation rate does not follow the frame rate
+        const double step = 1.0 / tick_rate_;
+        time_accumulator_ += std::max(0.0, dt);
+        size_t steps = static_cast<size_t>(time_accumulator_ / step);
+        if (steps > max_catch_up_steps_) {
+            // Too far behind (stall, breakpoint): drop the backlog instead of
+            // spiralling into ever longer updates
+            steps = max_catch_up_steps_;
+            time_accumulator_ = std::fmod(time_accumulator_, step) + steps * step;
+        }
+        time_accumulator_ -= steps * step;
+        
+        for (size_t i = 0; i < steps; ++i) {
+            if (i > 0 && i + 1 == steps) {
+                // After a catch-up batch renderers blend from the next-to-last step
+                previous_tick_fields_ = captureTickFields();
+            }
+            simulationStep(step);
+        }
+        
+        if (steps > 0) {
+            // Renderers blend from the previous tick's result towards this one
+            if (steps == 1) {
+                previous_tick_fields_ = std::move(last_tick_fields_);
+            }
+            last_tick_fields_ = captureTickFields();
+            fields_changed_since_tick_ = false;
+            simulation_time_ += steps * step;
         }
+        
+        // Published before the lock is released, so epochs reach readers in
+        // order and the snapshot holds exactly the state this update left
+        publishSnapshot();
     }
+}
+
+void AnantaSoundCore::simulationStep(double step) {
+    ThreadPool::shared().parallelFor(interference_fields_.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (interference_fields_[i]) {
+                interference_fields_[i]->updateQuantumState(step);
+            }
+        }
+    });
     
-    // Update quantum effects
-    static double time_accumulator = 0.0;
-    time_accumulator += dt;
+    // Simulate quantum decoherence. The draw for field i on tick t is
+    // Philox(seed, t, i), so the result does not depend on how the
+    // range is split between threads.
+    const double probability = 1.0 - std::pow(1.0 - kDecoherenceProbability, step / kDecoherenceInterval);
+    const uint64_t tick = update_tick_++;
+    const uint64_t seed = random_seed_;
+    SpatialFieldStore& fields = *sound_fields_;
+    ThreadPool::shared().parallelFor(fields.size(), kUpdateGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            QuantumSoundField& field = fields[i];
+            if (field.quantum_state == QuantumSoundState::SUPERPOSITION &&
+                philoxUniform(seed, tick, i) < probability) {
+                field.quantum_state = QuantumSoundState::GROUND;
+            }
+        }
+    });
+}
+
+std::shared_ptr<const AnantaSoundCore::TickFields> AnantaSoundCore::captureTickFields() const {
+    auto tick_fields = std::make_shared<TickFields>();
+    tick_fields->fields = sound_fields_->values();
+    tick_fields->ids = sound_fields_->ids();
+    return tick_fields;
+}
+
+void AnantaSoundCore::setTickRate(double hz) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    tick_rate_ = std::clamp(hz, 1.0, 1000.0);
+}
+
+double AnantaSoundCore::getTickRate() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return tick_rate_;
+}
+
+void AnantaSoundCore::setMaxCatchUpSteps(size_t steps) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    max_catch_up_steps_ = std::max<size_t>(1, steps);
+}
+
+size_t AnantaSoundCore::getMaxCatchUpSteps() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return max_catch_up_steps_;
+}
+
+std::vector<QuantumSoundField> AnantaSoundCore::getInterpolatedFields() const {
+    const auto snapshot = getSnapshot();
+    if (!snapshot->last_tick) {
+        return *snapshot->fields;
+    }
+    std::vector<QuantumSoundField> result = snapshot->last_tick->fields;
+    if (!snapshot->previous_tick) {
+        return result;
+    }
+    
+    // Blend each field of the last tick with its state at the tick before.
+    // Fields are matched by stable id: the dense index usually agrees, and a
+    // hash lookup covers fields moved by swap-removal. Fields without a
+    // counterpart are returned as they are at the last tick.
+    const TickFields& previous = *snapshot->previous_tick;
+    const std::vector<uint64_t>& ids = snapshot->last_tick->ids;
+    const double alpha = snapshot->interpolation_alpha;
+    std::unordered_map<uint64_t, size_t> previous_index;
     
-    if (time_accumulator >= 0.016) { // ~60 FPS
-        // Simulate quantum decoherence
-        for (auto& [pos, field] : sound_fields_) {
-            if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
-                static std::random_device rd;
-                static std::mt19937 gen(rd());
-                static std::uniform_real_distribution<double> dist(0.0, 1.0);
-                
-                if (dist(gen) < 0.05) { // 5% chance of decoherence
-                    field.quantum_state = QuantumSoundState::GROUND;
+    for (size_t i = 0; i < result.size(); ++i) {
+        size_t match = i;
+        if (i >= previous.ids.size() || previous.ids[i] != ids[i]) {
+            if (previous_index.empty()) {
+                previous_index.reserve(previous.ids.size());
+                for (size_t j = 0; j < previous.ids.size(); ++j) {
+                    previous_index.emplace(previous.ids[j], j);
                 }
             }
+            auto found = previous_index.find(ids[i]);
+            if (found == previous_index.end()) {
+                continue;
+            }
+            match = found->second;
         }
-        time_accumulator = 0.0;
+        
+        QuantumSoundField& current = result[i];
+        const QuantumSoundField& before = previous.fields[match];
+        current.amplitude = before.amplitude + alpha * (current.amplitude - before.amplitude);
+        current.phase = before.phase + alpha * std::remainder(current.phase - before.phase, 2.0 * M_PI);
     }
+    return result;
+}
+
+void AnantaSoundCore::setRandomSeed(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    random_seed_ = seed;
+    update_tick_ = 0;
+    noise_stream_.reseed(seed, kNoiseStream);
+}
+
+uint64_t AnantaSoundCore::getRandomSeed() const {
+    std::lock_guard<std::mutex> lock(core_mutex_);
+    return random_seed_;
 }
 
 AnantaSoundCore::SystemStatistics AnantaSoundCore::getStatistics() const {
-    SystemStatistics stats;
-    
     if (!is_initialized_) {
-        return stats;
+        return SystemStatistics{};
     }
     
     std::lock_guard<std::mutex> lock(core_mutex_);
+    return collectStatistics();
+}
+
+std::shared_ptr<const AnantaSoundCore::CoreSnapshot> AnantaSoundCore::getSnapshot() const {
+    return std::atomic_load(&snapshot_);
+}
+
+AnantaSoundCore::SystemStatistics AnantaSoundCore::collectStatistics() const {
+    SystemStatistics stats;
     
-    stats.active_fields = sound_fields_.size();
+    stats.active_fields = sound_fields_->size();
     
     // Count entangled pairs from interference fields
-    stats.entangled_pairs = 0;
     for (const auto& field : interference_fields_) {
         if (field) {
             stats.entangled_pairs += field->getEntangledPairsCount();
@@ -400,16 +1218,37 @@ AnantaSoundCore::SystemStatistics AnantaSoundCore::getStatistics() const {
     return stats;
 }
 
+void AnantaSoundCore::publishSnapshot() {
+    // Readers holding the previous snapshot keep it alive until they drop
+    // their handle. Fields unchanged since the last tick share its copy.
+    auto snapshot = std::make_shared<CoreSnapshot>();
+    snapshot->epoch = ++snapshot_epoch_;
+    if (last_tick_fields_ && !fields_changed_since_tick_) {
+        snapshot->fields = std::shared_ptr<const std::vector<QuantumSoundField>>(last_tick_fields_,
+                                                                                &last_tick_fields_->fields);
+    } else {
+        snapshot->fields = std::make_shared<const std::vector<QuantumSoundField>>(sound_fields_->values());
+    }
+    snapshot->previous_tick = previous_tick_fields_;
+    snapshot->last_tick = last_tick_fields_;
+    snapshot->simulation_time = simulation_time_;
+    snapshot->interpolation_alpha = std::min(time_accumulator_ * tick_rate_, 1.0);
+    if (is_initialized_) {
+        snapshot->statistics = collectStatistics();
+    }
+    std::atomic_store(&snapshot_, std::shared_ptr<const CoreSnapshot>(std::move(snapshot)));
+}
+
 // Helper methods implementation
 double AnantaSoundCore::calculateCoherenceRatio() const {
-    if (sound_fields_.empty()) {
+    if (sound_fields_->empty()) {
         return 0.0;
     }
     
     size_t coherent_fields = 0;
-    size_t total_fields = sound_fields_.size();
+    size_t total_fields = sound_fields_->size();
     
-    for (const auto& [pos, field] : sound_fields_) {
+    for (const auto& field : sound_fields_->values()) {
         if (field.quantum_state == QuantumSoundState::COHERENT || 
             field.quantum_state == QuantumSoundState::SUPERPOSITION) {
             coherent_fields++;
@@ -420,14 +1259,14 @@ double AnantaSoundCore::calculateCoherenceRatio() const {
 }
 
 double AnantaSoundCore::calculateEnergyEfficiency() const {
-    if (sound_fields_.empty()) {
+    if (sound_fields_->empty()) {
         return 1.0;
     }
     
     double total_energy = 0.0;
     double max_possible_energy = 0.0;
     
-    for (const auto& [pos, field] : sound_fields_) {
+    for (const auto& field : sound_fields_->values()) {
         double field_energy = std::abs(field.amplitude);
         total_energy += field_energy;
         max_possible_energy += 1.0; // Assuming max amplitude is 1.0
@@ -443,7 +1282,7 @@ double AnantaSoundCore::calculateEnergyEfficiency() const {
 bool AnantaSoundCore::checkQRDConnection() const {
     // Simulate QRD connection check
     // In a real implementation, this would check actual hardware connection
-    return !sound_fields_.empty() && interference_fields_.size() > 0;
+    return !sound_fields_->empty() && interference_fields_.size() > 0;
 }
 
 size_t AnantaSoundCore::countActiveMechanicalDevices() const {
@@ -452,7 +1291,7 @@ size_t AnantaSoundCore::countActiveMechanicalDevices() const {
     size_t device_count = 0;
     
     // Count devices based on active fields and their quantum states
-    for (const auto& [pos, field] : sound_fields_) {
+    for (const auto& field : sound_fields_->values()) {
         if (field.quantum_state == QuantumSoundState::EXCITED ||
             field.quantum_state == QuantumSoundState::ENTANGLED) {
             device_count++;
@@ -463,59 +1302,219 @@ size_t AnantaSoundCore::countActiveMechanicalDevices() const {
 }
 
 // QuantumAcousticProcessor implementation
-QuantumAcousticProcessor::QuantumAcousticProcessor(size_t max_fields)
-    : processing_enabled_(true) {
+QuantumAcousticProcessor::QuantumAcousticProcessor(size_t max_fields, size_t worker_count)
+    : max_fields_(max_fields)
+    , incoming_(std::min(max_fields, kMaxIncomingCapacity))
+    , accepted_fields_(0)
+    , clear_requested_(false)
+    , processing_enabled_(true)
+    , stopping_(false)
+    , math_accuracy_(getDefaultMathAccuracy())
+    , published_fields_(std::make_shared<std::vector<QuantumSoundField>>())
+    , recycler_(std::make_shared<BufferRecycler>()) {
+    if (worker_count == 0) {
+        worker_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    
+    // The processing thread takes part in every parallel pass, so the pool
+    // adds worker_count - 1 threads
+    if (worker_count > 1) {
+        worker_pool_ = std::make_unique<ThreadPool>(worker_count);
+    }
+    
+    const uint64_t seed = nextInstanceSeed();
+    shards_.resize(worker_count);
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        shards_[i].random.reseed(seed, i);
+    }
+    
     processing_thread_ = std::thread(&QuantumAcousticProcessor::processingLoop, this);
 }
 
 QuantumAcousticProcessor::~QuantumAcousticProcessor() {
-    processing_enabled_ = false;
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_cv_.notify_all();
     if (processing_thread_.joinable()) {
         processing_thread_.join();
     }
 }
 
-void QuantumAcousticProcessor::addField(const QuantumSoundField& field) {
-    std::lock_guard<std::mutex> lock(fields_mutex_);
-    fields_.push_back(field);
+bool QuantumAcousticProcessor::addField(const QuantumSoundField& field) {
+    // Reserve a slot in the bounded pool first, so the pool never grows past max_fields
+    size_t accepted = accepted_fields_.load(std::memory_order_relaxed);
+    do {
+        if (accepted >= max_fields_) {
+            return false;
+        }
+    } while (!accepted_fields_.compare_exchange_weak(accepted, accepted + 1, std::memory_order_relaxed));
+    
+    if (!incoming_.tryPush(field)) {
+        // The worker has not drained the queue yet; give the slot back
+        accepted_fields_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void QuantumAcousticProcessor::clearFields() {
+    clear_requested_.store(true, std::memory_order_release);
 }
 
 std::vector<QuantumSoundField> QuantumAcousticProcessor::getProcessedFields() const {
-    std::lock_guard<std::mutex> lock(fields_mutex_);
-    return fields_;
+    return *getProcessedSnapshot();
+}
+
+std::shared_ptr<const std::vector<QuantumSoundField>> QuantumAcousticProcessor::getProcessedSnapshot() const {
+    return std::atomic_load(&published_fields_);
 }
 
 void QuantumAcousticProcessor::setProcessingEnabled(bool enabled) {
     processing_enabled_ = enabled;
 }
 
+void QuantumAcousticProcessor::setMathAccuracy(MathAccuracy accuracy) {
+    math_accuracy_ = accuracy;
+}
+
+size_t QuantumAcousticProcessor::getMaxFields() const {
+    return max_fields_;
+}
+
+size_t QuantumAcousticProcessor::getWorkerCount() const {
+    return shards_.size();
+}
+
 void QuantumAcousticProcessor::processingLoop() {
-    while (processing_enabled_) {
-        std::lock_guard<std::mutex> lock(fields_mutex_);
+    // Fixed-rate schedule. Field data is owned by this thread, and the
+    // wait below holds only wake_mutex_, which producers never touch.
+    auto next_tick = std::chrono::steady_clock::now();
+    
+    while (!stopping_) {
+        if (clear_requested_.exchange(false, std::memory_order_acquire)) {
+            releaseFields();
+        }
+        drainIncoming();
+        if (processing_enabled_) {
+            processTick();
+        }
+        publishFields();
         
-        for (auto& field : fields_) {
-            // Apply quantum processing
-            field.amplitude *= std::exp(std::complex<double>(0.0, field.phase));
-            
-            // Update quantum state
-            if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
-                static std::random_device rd;
-                static std::mt19937 gen(rd());
-                static std::uniform_real_distribution<double> dist(0.0, 1.0);
-                
-                if (dist(gen) < 0.1) { // 10% chance of collapse
-                    field.quantum_state = QuantumSoundState::COLLAPSED;
-                }
-            }
+        next_tick += kProcessingTickInterval;
+        const auto now = std::chrono::steady_clock::now();
+        if (next_tick < now) {
+            next_tick = now; // fell behind: skip missed ticks instead of bursting
         }
         
-        std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait_until(lock, next_tick, [this] { return stopping_.load(); });
+    }
+}
+
+void QuantumAcousticProcessor::drainIncoming() {
+    // New fields extend the pool; shard ranges are rebalanced on every pass
+    QuantumSoundField field;
+    while (incoming_.tryPop(field)) {
+        fields_.push_back(field);
     }
 }
 
+void QuantumAcousticProcessor::releaseFields() {
+    // Fields leaving the pool give their slots back to addField
+    accepted_fields_.fetch_sub(fields_.size(), std::memory_order_relaxed);
+    fields_.clear();
+}
+
+void QuantumAcousticProcessor::processTick() {
+    const MathAccuracy accuracy = math_accuracy_;
+    forEachShard([this, accuracy](size_t index, size_t begin, size_t end) {
+        processShard(fields_.data() + begin, end - begin, shards_[index].random, accuracy);
+    });
+}
+
+void QuantumAcousticProcessor::processShard(QuantumSoundField* fields, size_t count, RandomStream& random,
+                                            MathAccuracy accuracy) {
+    for (size_t i = 0; i < count; ++i) {
+        QuantumSoundField& field = fields[i];
+        // Apply quantum processing
+        field.amplitude *= fastExpI(field.phase, accuracy);
+        
+        // Update quantum state
+        if (field.quantum_state == QuantumSoundState::SUPERPOSITION) {
+            if (random.nextUniform() < 0.1) { // 10% chance of collapse
+                field.quantum_state = QuantumSoundState::COLLAPSED;
+            }
+        }
+    }
+}
+
+void QuantumAcousticProcessor::forEachShard(const std::function<void(size_t, size_t, size_t)>& body) {
+    const size_t count = fields_.size();
+    const size_t shard_count = shards_.size();
+    auto run = [&body, count, shard_count](size_t index) {
+        body(index, index * count / shard_count, (index + 1) * count / shard_count);
+    };
+    
+    if (!worker_pool_) {
+        for (size_t i = 0; i < shard_count; ++i) {
+            run(i);
+        }
+        return;
+    }
+    worker_pool_->parallelFor(shard_count, 1, [&run](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            run(i);
+        }
+    });
+}
+
+void QuantumAcousticProcessor::publishFields() {
+    // Reuse the buffer the last reader of an older snapshot handed back
+    std::vector<QuantumSoundField>* buffer = recycler_->spare.exchange(nullptr, std::memory_order_acquire);
+    if (!buffer) {
+        buffer = new std::vector<QuantumSoundField>();
+    }
+    buffer->resize(fields_.size());
+    
+    // Merge: each shard copies its contiguous range to the same offset
+    QuantumSoundField* merged = buffer->data();
+    forEachShard([this, merged](size_t, size_t begin, size_t end) {
+        std::copy(fields_.begin() + begin, fields_.begin() + end, merged + begin);
+    });
+    
+    // Whoever drops the last reference returns the buffer with a release store,
+    // so its reads happen-before the next publish writes into it
+    std::shared_ptr<const std::vector<QuantumSoundField>> snapshot(
+        buffer, [recycler = recycler_](const std::vector<QuantumSoundField>* released) {
+            auto* spare = const_cast<std::vector<QuantumSoundField>*>(released);
+            std::vector<QuantumSoundField>* empty = nullptr;
+            if (!recycler->spare.compare_exchange_strong(empty, spare, std::memory_order_release)) {
+                delete spare;
+            }
+        });
+    std::atomic_store(&published_fields_, std::move(snapshot));
+}
+
 
 
 // Global functions
+std::complex<double> getQuantumStateFactor(QuantumSoundState state) {
+    switch (state) {
+        case QuantumSoundState::COHERENT:
+            return std::complex<double>(1.0, 0.0);
+        case QuantumSoundState::SUPERPOSITION:
+            return std::complex<double>(0.707, 0.707);
+        case QuantumSoundState::ENTANGLED:
+            return std::complex<double>(0.5, 0.866);
+        case QuantumSoundState::COLLAPSED:
+            return std::complex<double>(0.0, 1.0);
+        default:
+            return std::complex<double>(1.0, 0.0);
+    }
+}
+
 std::string getVersion() {
     return "2.1.0";
 }
@@ -10,6 +10,18 @@
 #include <cmath>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+
+#include "fast_math.hpp"
+#include "quantum_random.hpp"
+#include "mpsc_queue.hpp"
+#include "entanglement_graph.hpp"
+#include "slot_map.hpp"
+#include "source_bvh.hpp"
+#include "dome_modal_solver.hpp"
+#include "acoustic_material.hpp"
+#include "room_eq.hpp"
 
 namespace AnantaSound {
 
@@ -44,6 +56,9 @@ struct SphericalCoord {
     }
 };
 
+// Скорость звука (м/с)
+constexpr double kSpeedOfSound = 343.0;
+
 // Квантовое звуковое поле
 struct QuantumSoundField {
     std::complex<double> amplitude;    // Амплитуда (комплексная)
@@ -68,37 +83,163 @@ enum class InterferenceFieldType {
     QUANTUM_ENTANGLED    // Квантово-запутанная
 };
 
+class RoomResponseCache;
+
 // Интерференционное поле
 class InterferenceField {
 private:
+    // SoA-хранилище источников для горячего цикла calculateInterference.
+    // Индексы совпадают с плотными индексами source_fields_; значения пересчитываются при
+    // каждом изменении источника, а не при каждом вычислении.
+    struct SourceFieldStore {
+        std::vector<double> x;          // Кэшированные декартовы координаты
+        std::vector<double> y;
+        std::vector<double> z;
+        std::vector<double> gain_re;    // amplitude * quantum_factor
+        std::vector<double> gain_im;
+        std::vector<double> wavenumber; // 2π f / c
+        uint64_t version = 0;           // Растет при каждом изменении
+
+        size_t size() const { return x.size(); }
+        void push(const QuantumSoundField& field);
+        void update(size_t index, const QuantumSoundField& field);
+        void swapRemove(size_t index);      // Перенести последний элемент на место index
+    };
+
     InterferenceFieldType type_;
     SphericalCoord center_;
     double radius_;
-    std::vector<QuantumSoundField> source_fields_;
-    std::vector<std::pair<size_t, size_t>> entangled_pairs_;
+public:
+    // Стабильный дескриптор источника (не меняется при удалении других)
+    using SourceId = SlotHandle;
+
+private:
+    SlotMap<QuantumSoundField> source_fields_;
+    SourceFieldStore source_store_;
+    std::vector<double> excited_time_;          // Время в состоянии EXCITED (с), по плотным индексам
+    mutable EntanglementGraph entanglement_;    // Узлы - номера слотов source_fields_; запросы кластеров сжимают пути
+    
+    // Приближенное суммирование по дереву источников (0 - точная сумма)
+    double approximation_tolerance_;
+    mutable SourceBvh source_tree_;             // Перестраивается лениво по source_store_.version
+    mutable uint64_t source_tree_version_;     // Версия source_store_ при последней перестройке дерева
     double field_radius_;
+    MathAccuracy math_accuracy_;
+    std::shared_ptr<RoomResponseCache> room_response_;  // Ранние отражения купола, может быть общим
+    
+    // Отводы room_response_ для набора точек приема, строка на источник.
+    // Строка пересчитывается только после сдвига источника или смены точек,
+    // поэтому неподвижная сцена не обращается к общему кэшу
+    struct RoomTapRow {
+        double x = 0.0, y = 0.0, z = 0.0;  // Позиция источника при расчете
+        bool valid = false;
+        std::vector<uint32_t> offsets;      // Первый отвод каждой точки приема; точек + 1
+        std::vector<double> length;         // Длина пути отвода (м)
+        std::vector<double> gain;           // Усиление относительно прямого пути
+    };
+    struct RoomTapSet {
+        std::vector<double> receivers;      // x, y, z точек приема подряд
+        std::vector<RoomTapRow> rows;
+        size_t reserved_bytes = 0;          // Учтено в бюджете памяти room_response_
+    };
+    mutable RoomTapSet batch_taps_;         // Точки последнего пакета
+    mutable RoomTapSet point_taps_;         // Точка последнего calculateInterference
     mutable std::mutex field_mutex_;
 
 public:
     InterferenceField(InterferenceFieldType type, SphericalCoord center, double radius);
+    ~InterferenceField();
     
     // Добавить источник звукового поля
-    void addSourceField(const QuantumSoundField& field);
+    SourceId addSourceField(const QuantumSoundField& field);
+    
+    // Удалить источник за O(1): последний источник переносится на его место,
+    // идентификаторы остальных не меняются. Связи запутанности удаляются.
+    bool removeSourceField(SourceId id);
+    
+    size_t getSourceCount() const;
+    SourceId getSourceId(size_t index) const;   // Недействительный вне диапазона
+    bool getSourceField(SourceId id, QuantumSoundField& field) const;
     
     // Вычислить результирующую интерференцию в точке
     std::complex<double> calculateInterference(const SphericalCoord& position, double time) const;
     
+    // Вычислить интерференцию сразу для набора точек приема (массив динамиков,
+    // сетка визуализации). Мьютекс захватывается один раз, источники и точки
+    // обрабатываются тайлами, тайлы распределяются по потокам.
+    std::vector<std::complex<double>> calculateInterferenceBatch(const std::vector<SphericalCoord>& positions,
+                                                                 double time) const;
+    
     // Квантовая суперпозиция полей
     QuantumSoundField quantumSuperposition(const std::vector<QuantumSoundField>& fields) const;
     
-    // Обновить поле с учетом квантовых эффектов
+    // Обновить поле с учетом квантовых эффектов за время dt (с). Источник
+    // переходит из EXCITED в GROUND, пробыв возбужденным 0.1 с суммарно
     void updateQuantumState(double dt);
     
-    // Создать квантовую запутанность между полями
+    // Создать квантовую запутанность между полями (по текущим индексам)
     void createQuantumEntanglement(size_t field1_idx, size_t field2_idx);
     
-    // Получить количество запутанных пар
+    // То же по стабильным идентификаторам; false для неизвестных или совпадающих
+    bool entangleSources(SourceId first, SourceId second);
+    
+    // Получить количество запутанных пар (без повторов)
     size_t getEntangledPairsCount() const;
+    
+    // Кластер запутанности источника: представитель и члены, O(α(n))
+    SourceId getEntanglementCluster(SourceId id) const;
+    std::vector<SourceId> getEntanglementClusterMembers(SourceId id) const;
+    
+    // Коррелированное изменение состояния всего кластера источника;
+    // стоимость пропорциональна размеру кластера
+    void setClusterQuantumState(SourceId id, QuantumSoundState state);
+    
+    // Точность фазовых вычислений (FAST допустим для визуализации)
+    void setMathAccuracy(MathAccuracy accuracy);
+    MathAccuracy getMathAccuracy() const;
+    
+    // Допуск ε приближенного вычисления интерференции: погрешность не больше
+    // ε * Σ|g| источников. Далекие компактные и пренебрежимо слабые группы
+    // источников суммируются целиком по дереву. 0 - точная сумма.
+    void setApproximationTolerance(double tolerance);
+    double getApproximationTolerance() const;
+    
+    // Кэш передаточных данных купола: к прямому пути каждого источника
+    // добавляются отводы ранних отражений (g * Σ a_k exp(-i k L_k), a_k -
+    // усиление отвода относительно прямого звука). Вычисление идет точной
+    // суммой, без дерева. nullptr - только прямой путь. Отводы каждой пары
+    // запоминаются (отдельно для пакета и для одиночной точки), к кэшу
+    // вычисление обращается только для сдвинувшихся источников или новых
+    // точек приема. Память отводов учитывается в бюджете кэша; набор, не
+    // поместившийся в него, освобождается после вычисления.
+    void setRoomResponseCache(std::shared_ptr<RoomResponseCache> cache);
+    std::shared_ptr<RoomResponseCache> getRoomResponseCache() const;
+
+private:
+    // Суммы вкладов всех источников для тайла декартовых точек (без учета типа поля)
+    void accumulateReceiverTile(const double* x, const double* y, const double* z,
+                                size_t receiver_count, std::complex<double>* out) const;
+    
+    // Пересчитать устаревшие строки набора для точек приема x, y, z
+    void refreshRoomTaps(RoomTapSet& taps, const double* x, const double* y, const double* z,
+                         size_t receiver_count) const;
+    
+    // Учесть память набора в бюджете room_response_; false - набор не
+    // поместился и должен быть освобожден releaseRoomTaps после вычисления
+    bool reserveRoomTaps(RoomTapSet& taps) const;
+    void releaseRoomTaps(RoomTapSet& taps) const;
+    
+    // Сумма вкладов с прямым путем и отводами набора для точки receiver
+    std::complex<double> accumulateRoomTaps(const RoomTapSet& taps, size_t receiver,
+                                            double x, double y, double z) const;
+
+    // Применить эффект типа интерференции к суммарному полю
+    std::complex<double> applyInterferenceType(const std::complex<double>& total_field, double time) const;
+    
+    // Вызываются под field_mutex_
+    bool useSourceTree() const;
+    void entangleLocked(SourceId first, SourceId second);
+    void setSourceStateLocked(size_t index, QuantumSoundState state);
 };
 
 // Акустический резонатор для купола
@@ -106,53 +247,185 @@ class DomeAcousticResonator {
 private:
     double dome_radius_;
     double dome_height_;
+    DomeShapeModel shape_model_;
     std::vector<double> resonant_frequencies_;
-    std::map<double, double> acoustic_properties_;
+    
+    // Множители времени реверберации по частотам (setMaterialProperties)
+    std::vector<double> property_frequencies_;
+    std::vector<double> property_multipliers_;
+    
+    AcousticMaterial material_;
+    bool has_material_;                 // Иначе - эмпирическая формула
+    ReverbFormula reverb_formula_;
+    
+    RoomEqSettings eq_settings_;
+    RoomEqResult correction_;           // Последний подобранный эквалайзер
+    
+    // Пересчитать собственные частоты до частоты Шредера; вызывается при
+    // смене геометрии и всего, что влияет на T60
+    void updateResonantFrequencies();
 
 public:
     DomeAcousticResonator(double radius, double height);
     
-    // Вычислить собственные частоты купола
+    double getRadius() const { return dome_radius_; }
+    double getHeight() const { return dome_height_; }
+    
+    // Вычислить собственные частоты купола до частоты Шредера
     std::vector<double> calculateEigenFrequencies() const;
     
-    // Моделирование акустических свойств материалов
+    // Собственные частоты до max_frequency (вырожденные моды - один раз)
+    std::vector<double> calculateEigenFrequencies(double max_frequency) const;
+    
+    // Моды с индексами и кратностью (кэшируются на геометрию)
+    DomeModeList getModes(double max_frequency) const;
+    
+    // Модель геометрии; по умолчанию цилиндр
+    void setShapeModel(DomeShapeModel model);
+    DomeShapeModel getShapeModel() const { return shape_model_; }
+    
+    const std::vector<double>& getResonantFrequencies() const { return resonant_frequencies_; }
+    
+    // Объем купола и частота Шредера 2000 * sqrt(T60 / V), выше которой
+    // моды перекрываются и поле считается диффузным
+    double getVolume() const;
+    double getSurfaceArea() const;
+    double getSchroederFrequency() const;
+    
+    // Множители времени реверберации по частотам; между точками -
+    // интерполяция по логарифму частоты
     void setMaterialProperties(const std::map<double, double>& properties);
     
+    // Материал поверхностей: время реверберации по Сэбину или Эйрингу
+    void setMaterial(const AcousticMaterial& material);
+    const AcousticMaterial& getMaterial() const { return material_; }
+    void setReverbFormula(ReverbFormula formula);
+    ReverbFormula getReverbFormula() const { return reverb_formula_; }
+    
     // Вычислить время реверберации
     double calculateReverbTime(double frequency) const;
     
-    // Оптимизация частотной характеристики
+    // Время реверберации для набора частот
+    std::vector<double> calculateReverbTimes(const std::vector<double>& frequencies) const;
+    
+    // Усредненная по помещению модальная АЧХ (дБ): мощностная сумма
+    // резонансов с затуханием 3 ln(10) / T60 на частоте каждой моды
+    std::vector<double> calculateModalResponse(const std::vector<double>& frequencies) const;
+    
+    // Оптимизация частотной характеристики: подбор каскада пиковых фильтров,
+    // выравнивающего модальную АЧХ на заданных частотах (пустой вектор -
+    // сетка 1/24 октавы от 20 Гц до частоты Шредера). Предыдущие полосы
+    // служат начальным приближением, поэтому повторный подбор после
+    // изменения поглощения сходится за несколько итераций.
     void optimizeFrequencyResponse(const std::vector<double>& target_frequencies);
+    
+    // То же с целевой кривой target_db (дБ, с точностью до константы)
+    void optimizeFrequencyResponse(const std::vector<double>& frequencies,
+                                   const std::vector<double>& target_db);
+    
+    void setEqSettings(const RoomEqSettings& settings) { eq_settings_ = settings; }
+    const RoomEqSettings& getEqSettings() const { return eq_settings_; }
+    
+    // Результат подбора и готовый каскад фильтров для частоты eq_settings_.sample_rate
+    const RoomEqResult& getCorrection() const { return correction_; }
+    BiquadCascade getCorrectionFilters() const;
+
+private:
+    // Эмпирическая оценка без материала
+    double empiricalReverbTime() const;
 };
 
-// Квантовый акустический процессор
+class ThreadPool;
+
+// Квантовый акустический процессор.
+// Поля поступают через очередь без блокировок и обрабатываются собственным
+// потоком с фиксированной частотой; результаты публикуются неизменяемыми
+// снимками, так что ни производители, ни читатели не ждут поток обработки.
+// При worker_count > 1 поля делятся на шарды, которые обрабатываются
+// параллельно собственным пулом потоков.
 class QuantumAcousticProcessor {
 private:
-    std::vector<QuantumSoundField> fields_;
+    // Шард i из N владеет непрерывным диапазоном полей [i·n/N, (i+1)·n/N)
+    // и своим генератором, поэтому обработка и публикация шардов пишут
+    // в разные участки памяти, а порядок добавления сохраняется
+    struct alignas(64) Shard {
+        RandomStream random;
+    };
+    
+    size_t max_fields_;
+    std::vector<QuantumSoundField> fields_;             // Принадлежат потоку обработки
+    std::vector<Shard> shards_;
+    std::unique_ptr<ThreadPool> worker_pool_;           // nullptr при одном рабочем потоке
+    BoundedMpscQueue<QuantumSoundField> incoming_;      // Новые поля от addField
+    std::atomic<size_t> accepted_fields_;               // Полей в пуле и очереди (не больше max_fields_)
+    std::atomic<bool> clear_requested_;
     std::atomic<bool> processing_enabled_;
+    std::atomic<bool> stopping_;
+    std::atomic<MathAccuracy> math_accuracy_;
+    
+    // Буфер, освобожденный последним читателем снимка. Удалитель снимка
+    // кладет буфер сюда (release), поток обработки забирает его (acquire)
+    // при следующей публикации; живет, пока жив хоть один снимок
+    struct BufferRecycler {
+        std::atomic<std::vector<QuantumSoundField>*> spare{nullptr};
+        ~BufferRecycler() { delete spare.load(); }
+    };
+    
+    // Двойная буферизация результатов: опубликованный снимок и буфер,
+    // возвращенный читателями, который переиспользуется при следующей публикации
+    std::shared_ptr<const std::vector<QuantumSoundField>> published_fields_;
+    std::shared_ptr<BufferRecycler> recycler_;
+    
+    std::mutex wake_mutex_;                             // Только для ожидания тика и остановки
+    std::condition_variable wake_cv_;
     std::thread processing_thread_;
-    mutable std::mutex fields_mutex_;
 
 public:
-    explicit QuantumAcousticProcessor(size_t max_fields);
+    // worker_count == 0 - по числу аппаратных потоков
+    explicit QuantumAcousticProcessor(size_t max_fields, size_t worker_count = 1);
     ~QuantumAcousticProcessor();
     
-    void addField(const QuantumSoundField& field);
+    // Не блокируется; false, если достигнут предел max_fields
+    bool addField(const QuantumSoundField& field);
+    
+    // Удалить все поля из пула на следующем тике (поля в очереди остаются);
+    // освободившиеся места снова доступны addField
+    void clearFields();
+    
+    // Результаты последнего тика (копия и разделяемый снимок без копирования)
     std::vector<QuantumSoundField> getProcessedFields() const;
+    std::shared_ptr<const std::vector<QuantumSoundField>> getProcessedSnapshot() const;
+    
+    // Пауза обработки; новые поля продолжают приниматься и публиковаться
     void setProcessingEnabled(bool enabled);
+    void setMathAccuracy(MathAccuracy accuracy);
+    size_t getMaxFields() const;
+    size_t getWorkerCount() const;
     
 private:
     void processingLoop();
+    void drainIncoming();
+    void releaseFields();
+    void processTick();
+    void publishFields();
+    
+    // body(shard_index, begin, end) для диапазонов полей всех шардов,
+    // параллельно при наличии пула
+    void forEachShard(const std::function<void(size_t, size_t, size_t)>& body);
+    static void processShard(QuantumSoundField* fields, size_t count, RandomStream& random,
+                             MathAccuracy accuracy);
 };
 
 
 
+class SpatialFieldStore;
+
 // Основной класс AnantaSound
 class AnantaSoundCore {
 private:
-    std::vector<std::unique_ptr<InterferenceField>> interference_fields_;
+    SlotMap<std::unique_ptr<InterferenceField>> interference_fields_;
     std::unique_ptr<DomeAcousticResonator> dome_resonator_;
-    std::map<SphericalCoord, QuantumSoundField> sound_fields_;
+    std::unique_ptr<SpatialFieldStore> sound_fields_;
     mutable std::mutex core_mutex_;
     
     // Параметры системы
@@ -160,6 +433,32 @@ private:
     double dome_height_;
     double quantum_uncertainty_;
     bool is_initialized_;
+    
+    // Генератор квантового шума (собственный у каждого экземпляра)
+    RandomStream noise_stream_;
+    std::vector<double> noise_buffer_;
+    
+    // Опубликованный снимок; доступ только через std::atomic_load/atomic_store
+public:
+    struct CoreSnapshot;
+    struct TickFields;
+private:
+    std::shared_ptr<const CoreSnapshot> snapshot_;
+    uint64_t snapshot_epoch_;
+    
+    // Состояние параллельного update(): зерно счетного генератора
+    // и номер тика декогеренции
+    uint64_t random_seed_;
+    uint64_t update_tick_;
+    
+    // Часы с фиксированным шагом
+    double tick_rate_;                  // Частота тиков симуляции (Гц)
+    size_t max_catch_up_steps_;         // Предел шагов за один update()
+    double time_accumulator_;           // Непрошедшая доля шага (с)
+    double simulation_time_;            // Время симуляции на последнем тике (с)
+    std::shared_ptr<const TickFields> previous_tick_fields_;    // Результат предпоследнего тика
+    std::shared_ptr<const TickFields> last_tick_fields_;        // Результат последнего тика
+    bool fields_changed_since_tick_;    // Прием полей после last_tick_fields_
 
 public:
     AnantaSoundCore(double radius, double height);
@@ -169,9 +468,15 @@ public:
     bool initialize();
     void shutdown();
     
-    // Управление интерференционными полями
-    void addInterferenceField(std::unique_ptr<InterferenceField> field);
+    // Управление интерференционными полями. Дескриптор остается действительным,
+    // пока поле не удалено; плотный индекс может измениться при удалении других
+    // по дескриптору (O(1)). Удаление по индексу сохраняет порядок остальных полей.
+    using InterferenceFieldHandle = SlotHandle;
+    InterferenceFieldHandle addInterferenceField(std::unique_ptr<InterferenceField> field);
+    bool removeInterferenceField(InterferenceFieldHandle handle);
     void removeInterferenceField(size_t field_index);
+    InterferenceField* getInterferenceField(InterferenceFieldHandle handle) const;
+    size_t getInterferenceFieldCount() const;
     
     // Создание квантовых звуковых полей
     QuantumSoundField createQuantumSoundField(double frequency, 
@@ -181,25 +486,98 @@ public:
     // Обработка звукового поля
     void processSoundField(const QuantumSoundField& input_field);
     
+    // Пакетная обработка: один захват мьютекса, резервирование емкости
+    // и генерация шума блоком для всего пакета
+    void processSoundFields(const QuantumSoundField* input_fields, size_t count);
+    void processSoundFields(const std::vector<QuantumSoundField>& input_fields);
+    
     // Получение результирующего звукового поля
     std::vector<QuantumSoundField> getOutputFields() const;
     
-    // Обновление системы
+    // Поля в радиусе radius (м) от позиции
+    std::vector<QuantumSoundField> getFieldsNear(const SphericalCoord& position, double radius) const;
+    
+    // Обновление системы. dt накапливается, симуляция продвигается целыми
+    // шагами 1/tick_rate (не больше max_catch_up_steps за вызов, лишнее
+    // отбрасывается). Шаги выполняются параллельно на общем пуле потоков
+    // под core_mutex_; при одинаковом зерне результат не зависит от числа потоков.
     void update(double dt);
     
+    // Частота тиков симуляции, 1..1000 Гц (по умолчанию 60)
+    void setTickRate(double hz);
+    double getTickRate() const;
+    
+    // Предел шагов догоняния за один update() (по умолчанию 5)
+    void setMaxCatchUpSteps(size_t steps);
+    size_t getMaxCatchUpSteps() const;
+    
+    // Зерно генераторов декогеренции и квантового шума
+    // (по умолчанию nextInstanceSeed())
+    void setRandomSeed(uint64_t seed);
+    uint64_t getRandomSeed() const;
+    
     // Получение статистики системы
     struct SystemStatistics {
-        size_t active_fields;
-        size_t entangled_pairs;
-        double coherence_ratio;
-        double energy_efficiency;
-        bool qrd_connected;
-        size_t mechanical_devices_active;
+        size_t active_fields = 0;
+        size_t entangled_pairs = 0;
+        double coherence_ratio = 0.0;
+        double energy_efficiency = 0.0;
+        bool qrd_connected = false;
+        size_t mechanical_devices_active = 0;
     };
     
     SystemStatistics getStatistics() const;
     
+    // Поля на момент тика симуляции; ids[i] - стабильный идентификатор
+    // fields[i] (SpatialFieldStore::ids), не зависящий от плотного индекса
+    struct TickFields {
+        std::vector<QuantumSoundField> fields;
+        std::vector<uint64_t> ids;
+    };
+    
+    // Неизменяемый снимок выхода ядра, публикуемый один раз за update()
+    struct CoreSnapshot {
+        uint64_t epoch = 0;                     // Номер публикации
+        // Поля на конец update(); совпадает с last_tick->fields, если
+        // после тика не было приема. Никогда не nullptr
+        std::shared_ptr<const std::vector<QuantumSoundField>> fields;
+        SystemStatistics statistics;
+        
+        // Результаты двух последних тиков и доля шага, прошедшая после
+        // последнего, для плавного рендеринга между тиками
+        std::shared_ptr<const TickFields> previous_tick;
+        std::shared_ptr<const TickFields> last_tick;
+        double simulation_time = 0.0;
+        double interpolation_alpha = 0.0;       // [0, 1]
+    };
+    
+    // Последний опубликованный снимок. Не захватывает core_mutex_ и мьютексы
+    // полей: рендереры и UI могут опрашивать его с любой частотой.
+    // Никогда не возвращает nullptr.
+    std::shared_ptr<const CoreSnapshot> getSnapshot() const;
+    
+    // Поля последнего тика, интерполированные от состояния предыдущего тика
+    // по interpolation_alpha; поля сопоставляются по идентификатору, поля без
+    // пары возвращаются как есть (без блокировок)
+    std::vector<QuantumSoundField> getInterpolatedFields() const;
+    
 private:
+    // Один шаг симуляции длительностью step (с): интерференционные поля
+    // и декогеренция; вызывается под core_mutex_
+    void simulationStep(double step);
+    
+    // Копия полей и идентификаторов для интерполяции; вызывается под core_mutex_
+    std::shared_ptr<const TickFields> captureTickFields() const;
+    
+    // Собрать статистику; вызывается под core_mutex_
+    SystemStatistics collectStatistics() const;
+    
+    // Собрать и опубликовать новый снимок; вызывается под core_mutex_
+    void publishSnapshot();
+    
+    // Заполнить noise_buffer_ count нормальными отсчетами N(0, quantum_uncertainty_)
+    void generateQuantumNoise(size_t count);
+    
     // Helper methods for statistics calculation
     double calculateCoherenceRatio() const;
     double calculateEnergyEfficiency() const;
@@ -207,6 +585,9 @@ private:
     size_t countActiveMechanicalDevices() const;
 };
 
+// Комплексный множитель квантового состояния, применяемый к амплитуде источника
+std::complex<double> getQuantumStateFactor(QuantumSoundState state);
+
 // Объявления внешних функций
 std::string getVersion();
 std::string getBuildInfo();
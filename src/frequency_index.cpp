@@ -0,0 +1,31 @@
+#include "frequency_index.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace AnantaSound {
+
+void FrequencyIndex::build(const double* frequencies, size_t count, const double* weights) {
+    order_.resize(count);
+    std::iota(order_.begin(), order_.end(), size_t(0));
+    std::stable_sort(order_.begin(), order_.end(),
+                     [frequencies](size_t a, size_t b) { return frequencies[a] < frequencies[b]; });
+
+    frequencies_.resize(count);
+    weight_prefix_.resize(count + 1);
+    weight_prefix_[0] = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        frequencies_[i] = frequencies[order_[i]];
+        weight_prefix_[i + 1] = weight_prefix_[i] + (weights ? weights[order_[i]] : 1.0);
+    }
+}
+
+std::pair<size_t, size_t> FrequencyIndex::range(double center, double half_width) const {
+    if (half_width < 0.0) {
+        return {0, 0};
+    }
+    auto begin = std::lower_bound(frequencies_.begin(), frequencies_.end(), center - half_width);
+    auto end = std::upper_bound(begin, frequencies_.end(), center + half_width);
+    return {static_cast<size_t>(begin - frequencies_.begin()), static_cast<size_t>(end - frequencies_.begin())};
+}
+
+} // namespace AnantaSound
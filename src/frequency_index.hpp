@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Индекс полей по частоте: перестановка по возрастанию частоты и
+// префиксные суммы неотрицательных весов в этом порядке. Поля в полосе
+// |f - center| <= half_width образуют непрерывный диапазон, который
+// находится двоичным поиском, а суммарный вес полей вне полосы - за O(1).
+// Используется для отбора пар с близкими частотами вместо перебора всех пар.
+class FrequencyIndex {
+private:
+    std::vector<size_t> order_;         // Исходные индексы по возрастанию частоты
+    std::vector<double> frequencies_;   // Отсортированные частоты
+    std::vector<double> weight_prefix_; // weight_prefix_[i] - сумма весов первых i полей
+
+public:
+    FrequencyIndex() = default;
+
+    // weights == nullptr - единичные веса
+    void build(const double* frequencies, size_t count, const double* weights = nullptr);
+
+    // Диапазон [begin, end) отсортированного порядка с |f - center| <= half_width
+    std::pair<size_t, size_t> range(double center, double half_width) const;
+
+    // Сумма весов в отсортированном диапазоне и вне его
+    double weightIn(size_t begin, size_t end) const { return weight_prefix_[end] - weight_prefix_[begin]; }
+    double weightOutside(size_t begin, size_t end) const { return totalWeight() - weightIn(begin, end); }
+    double totalWeight() const { return weight_prefix_.empty() ? 0.0 : weight_prefix_.back(); }
+
+    const std::vector<size_t>& order() const { return order_; }
+    const std::vector<double>& sortedFrequencies() const { return frequencies_; }
+    size_t size() const { return order_.size(); }
+    bool empty() const { return order_.empty(); }
+};
+
+} // namespace AnantaSound
@@ -5,6 +5,13 @@
 
 namespace AnantaSound {
 
+namespace {
+
+// Solfeggio frequencies of the seven chakras used by SpiritualMercy
+constexpr double kChakraFrequencies[7] = {396, 417, 528, 639, 741, 852, 963};
+
+} // namespace
+
 // MechanicalDevice implementation
 MechanicalDevice::MechanicalDevice(DeviceType type, const SphericalCoord& position)
     : device_type_(type), position_(position), is_active_(true), vibration_enabled_(true) {
@@ -77,11 +84,18 @@ void KarmicCluster::setHealingEnabled(bool enabled) {
 }
 
 std::vector<QuantumSoundField> KarmicCluster::generateKarmicFields() const {
+    std::vector<QuantumSoundField> karmic_fields;
+    generateKarmicFields(karmic_fields);
+    return karmic_fields;
+}
+
+size_t KarmicCluster::generateKarmicFields(std::vector<QuantumSoundField>& out) const {
     if (!isActive() || !healing_enabled_) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> karmic_fields;
+    const size_t first = out.size();
+    const auto timestamp = std::chrono::high_resolution_clock::now();
     
     for (const auto& element : cluster_elements_) {
         if (!element.is_active) continue;
@@ -95,12 +109,12 @@ std::vector<QuantumSoundField> KarmicCluster::generateKarmicFields() const {
         field.frequency = element.resonance_frequency;
         field.quantum_state = QuantumSoundState::COHERENT;
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
+        field.timestamp = timestamp;
         
-        karmic_fields.push_back(field);
+        out.push_back(field);
     }
     
-    return karmic_fields;
+    return out.size() - first;
 }
 
 void KarmicCluster::updateKarmicCharge(size_t element_id, double charge) {
@@ -152,11 +166,17 @@ void SpiritualMercy::setCompassionRadius(double radius) {
 }
 
 std::vector<QuantumSoundField> SpiritualMercy::generateMercyFields() const {
+    std::vector<QuantumSoundField> mercy_fields;
+    generateMercyFields(mercy_fields);
+    return mercy_fields;
+}
+
+size_t SpiritualMercy::generateMercyFields(std::vector<QuantumSoundField>& out) const {
     if (!isActive() || !forgiveness_enabled_) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> mercy_fields;
+    const auto timestamp = std::chrono::high_resolution_clock::now();
     
     // Generate mercy fields based on mercy level
     for (int i = 0; i < 7; ++i) { // Seven chakras
@@ -169,18 +189,17 @@ std::vector<QuantumSoundField> SpiritualMercy::generateMercyFields() const {
         );
         
         // Chakra frequencies
-        std::vector<double> chakra_frequencies = {396, 417, 528, 639, 741, 852, 963};
-        field.frequency = chakra_frequencies[i % chakra_frequencies.size()];
+        field.frequency = kChakraFrequencies[i];
         
         field.phase = i * M_PI / 7.0;
         field.quantum_state = QuantumSoundState::SUPERPOSITION;
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
+        field.timestamp = timestamp;
         
-        mercy_fields.push_back(field);
+        out.push_back(field);
     }
     
-    return mercy_fields;
+    return 7;
 }
 
 // QuantumResonanceDevice implementation
@@ -214,11 +233,17 @@ void QuantumResonanceDevice::setEntanglementEnabled(bool enabled) {
 }
 
 std::vector<QuantumSoundField> QuantumResonanceDevice::generateResonanceFields() const {
+    std::vector<QuantumSoundField> resonance_fields;
+    generateResonanceFields(resonance_fields);
+    return resonance_fields;
+}
+
+size_t QuantumResonanceDevice::generateResonanceFields(std::vector<QuantumSoundField>& out) const {
     if (!isActive()) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> resonance_fields;
+    const auto timestamp = std::chrono::high_resolution_clock::now();
     
     // Generate harmonic resonance fields
     for (int harmonic = 1; harmonic <= 8; ++harmonic) {
@@ -241,12 +266,12 @@ std::vector<QuantumSoundField> QuantumResonanceDevice::generateResonanceFields()
         }
         
         field.position = position_;
-        field.timestamp = std::chrono::high_resolution_clock::now();
+        field.timestamp = timestamp;
         
-        resonance_fields.push_back(field);
+        out.push_back(field);
     }
     
-    return resonance_fields;
+    return 8;
 }
 
 // MechanicalDeviceManager implementation
@@ -266,20 +291,36 @@ void MechanicalDeviceManager::setAutoSyncEnabled(bool enabled) {
     auto_sync_enabled_ = enabled;
 }
 
-void MechanicalDeviceManager::addDevice(std::shared_ptr<MechanicalDevice> device) {
-    if (device) {
-        devices_.push_back(device);
-        device_count_ = devices_.size();
+MechanicalDeviceManager::DeviceHandle MechanicalDeviceManager::addDevice(std::shared_ptr<MechanicalDevice> device) {
+    if (!device) {
+        return DeviceHandle{};
     }
+    DeviceHandle handle = devices_.insert(std::move(device));
+    device_count_ = devices_.size();
+    return handle;
+}
+
+bool MechanicalDeviceManager::removeDevice(DeviceHandle handle) {
+    if (!devices_.erase(handle)) {
+        return false;
+    }
+    device_count_ = devices_.size();
+    return true;
 }
 
 void MechanicalDeviceManager::removeDevice(size_t device_id) {
     if (device_id < devices_.size()) {
-        devices_.erase(devices_.begin() + device_id);
+        // Index-based callers rely on the order of the remaining devices
+        devices_.eraseDenseOrdered(device_id);
         device_count_ = devices_.size();
     }
 }
 
+std::shared_ptr<MechanicalDevice> MechanicalDeviceManager::getDevice(DeviceHandle handle) const {
+    const auto* device = devices_.get(handle);
+    return device ? *device : nullptr;
+}
+
 std::shared_ptr<MechanicalDevice> MechanicalDeviceManager::getDevice(size_t device_id) const {
     if (device_id < devices_.size()) {
         return devices_[device_id];
@@ -289,42 +330,46 @@ std::shared_ptr<MechanicalDevice> MechanicalDeviceManager::getDevice(size_t devi
 
 std::vector<QuantumSoundField> MechanicalDeviceManager::generateAllDeviceFields() const {
     std::vector<QuantumSoundField> all_fields;
+    generateAllDeviceFields(all_fields);
+    return all_fields;
+}
+
+size_t MechanicalDeviceManager::generateAllDeviceFields(std::vector<QuantumSoundField>& out) const {
+    const size_t first = out.size();
     
     for (const auto& device : devices_) {
         if (!device || !device->isActive()) continue;
         
-        std::vector<QuantumSoundField> device_fields;
-        
-        // Generate fields based on device type
+        // Generate fields based on device type, appending straight into out
         switch (device->getDeviceType()) {
             case DeviceType::KARMIC_CLUSTER: {
-                auto karmic_device = std::dynamic_pointer_cast<KarmicCluster>(device);
-                if (karmic_device) {
-                    device_fields = karmic_device->generateKarmicFields();
+                if (auto* karmic_device = dynamic_cast<const KarmicCluster*>(device.get())) {
+                    karmic_device->generateKarmicFields(out);
                 }
                 break;
             }
             case DeviceType::SPIRITUAL_MERCY: {
-                auto mercy_device = std::dynamic_pointer_cast<SpiritualMercy>(device);
-                if (mercy_device) {
-                    device_fields = mercy_device->generateMercyFields();
+                if (auto* mercy_device = dynamic_cast<const SpiritualMercy*>(device.get())) {
+                    mercy_device->generateMercyFields(out);
                 }
                 break;
             }
             case DeviceType::QUANTUM_RESONANCE: {
-                auto resonance_device = std::dynamic_pointer_cast<QuantumResonanceDevice>(device);
-                if (resonance_device) {
-                    device_fields = resonance_device->generateResonanceFields();
+                if (auto* resonance_device = dynamic_cast<const QuantumResonanceDevice*>(device.get())) {
+                    resonance_device->generateResonanceFields(out);
                 }
                 break;
             }
         }
-        
-        // Add device fields to total
-        all_fields.insert(all_fields.end(), device_fields.begin(), device_fields.end());
     }
     
-    return all_fields;
+    return out.size() - first;
+}
+
+FieldRange MechanicalDeviceManager::generateAllDeviceFields(FieldArena& arena) const {
+    const size_t mark = arena.size();
+    generateAllDeviceFields(arena.buffer());
+    return arena.since(mark);
 }
 
 void MechanicalDeviceManager::synchronizeDevices() {
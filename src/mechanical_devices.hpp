@@ -1,6 +1,8 @@
 #pragma once
 
 #include "anantasound_core.hpp"
+#include "slot_map.hpp"
+#include "field_arena.hpp"
 #include <vector>
 #include <memory>
 
@@ -67,8 +69,10 @@ public:
     void activateElement(size_t element_id);
     void deactivateElement(size_t element_id);
     
-    // Генерация полей
+    // Генерация полей; вариант с буфером дописывает поля в out и
+    // возвращает их число
     std::vector<QuantumSoundField> generateKarmicFields() const;
+    size_t generateKarmicFields(std::vector<QuantumSoundField>& out) const;
 };
 
 // Духовное милосердие
@@ -91,6 +95,7 @@ public:
     
     // Генерация полей
     std::vector<QuantumSoundField> generateMercyFields() const;
+    size_t generateMercyFields(std::vector<QuantumSoundField>& out) const;
 };
 
 // Квантовое резонансное устройство
@@ -113,12 +118,13 @@ public:
     
     // Генерация полей
     std::vector<QuantumSoundField> generateResonanceFields() const;
+    size_t generateResonanceFields(std::vector<QuantumSoundField>& out) const;
 };
 
 // Менеджер механических устройств
 class MechanicalDeviceManager {
 private:
-    std::vector<std::shared_ptr<MechanicalDevice>> devices_;
+    SlotMap<std::shared_ptr<MechanicalDevice>> devices_;
     size_t device_count_;
     bool auto_sync_enabled_;
 
@@ -129,12 +135,26 @@ public:
     size_t getDeviceCount() const;
     bool isAutoSyncEnabled() const;
     void setAutoSyncEnabled(bool enabled);
-    void addDevice(std::shared_ptr<MechanicalDevice> device);
+    
+    // Дескриптор устройства стабилен до его удаления (горячее подключение).
+    // Перегрузки с size_t работают с плотным индексом: удаление по индексу
+    // сохраняет порядок остальных устройств (O(n)), удаление по дескриптору
+    // выполняется за O(1) и переносит последнее устройство на место удаленного
+    using DeviceHandle = SlotHandle;
+    DeviceHandle addDevice(std::shared_ptr<MechanicalDevice> device);
+    bool removeDevice(DeviceHandle handle);
     void removeDevice(size_t device_id);
+    std::shared_ptr<MechanicalDevice> getDevice(DeviceHandle handle) const;
     std::shared_ptr<MechanicalDevice> getDevice(size_t device_id) const;
     
     // Операции с устройствами
     std::vector<QuantumSoundField> generateAllDeviceFields() const;
+    
+    // Поля всех устройств дописываются в out без промежуточных векторов
+    size_t generateAllDeviceFields(std::vector<QuantumSoundField>& out) const;
+    
+    // То же в кадровый буфер (arena.reset() - забота вызывающего в начале тика)
+    FieldRange generateAllDeviceFields(FieldArena& arena) const;
     void synchronizeDevices();
 };
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Ограниченная очередь "много производителей - один потребитель" без блокировок
+// (кольцевой буфер Д. Вьюкова с номерами последовательности в ячейках).
+// tryPush можно вызывать из любых потоков, tryPop - только из одного.
+// Память выделяется один раз в конструкторе.
+template <typename T>
+class BoundedMpscQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> enqueue_position_;
+    alignas(64) size_t dequeue_position_;
+
+public:
+    // Емкость округляется вверх до степени двойки (не меньше 2)
+    explicit BoundedMpscQueue(size_t capacity)
+        : enqueue_position_(0), dequeue_position_(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // false, если очередь заполнена
+    bool tryPush(const T& value) {
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                            std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // false, если очередь пуста. Только для потока-потребителя.
+    bool tryPop(T& out) {
+        Cell& cell = cells_[dequeue_position_ & mask_];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(dequeue_position_ + 1) < 0) {
+            return false;
+        }
+        out = std::move(cell.value);
+        cell.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_position_;
+        return true;
+    }
+};
+
+} // namespace AnantaSound
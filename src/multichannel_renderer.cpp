@@ -0,0 +1,290 @@
+#include "multichannel_renderer.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Cubic interpolation reads one sample ahead of the integer delay,
+// so delays shorter than this would touch samples not yet synthesized
+constexpr double kMinDelaySamples = 2.0;
+
+size_t nextPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+void toCartesian(const SphericalCoord& p, double& x, double& y, double& z) {
+    x = p.r * std::sin(p.theta) * std::cos(p.phi);
+    y = p.r * std::sin(p.theta) * std::sin(p.phi);
+    z = p.height;
+}
+
+// 4-point, 3rd-order Hermite interpolation weights for y[-1], y[0], y[1], y[2]
+inline void hermiteWeights(float t, float& wm1, float& w0, float& w1, float& w2) {
+    float t2 = t * t;
+    float t3 = t2 * t;
+    wm1 = -0.5f * t + t2 - 0.5f * t3;
+    w0 = 1.0f - 2.5f * t2 + 1.5f * t3;
+    w1 = 0.5f * t + 2.0f * t2 - 1.5f * t3;
+    w2 = -0.5f * t2 + 0.5f * t3;
+}
+
+} // namespace
+
+MultichannelRenderer::MultichannelRenderer(const std::vector<SphericalCoord>& speaker_positions,
+                                           const RendererConfig& config)
+    : config_(config), history_length_(0), history_guard_(0), history_stride_(0), write_position_(0) {
+    
+    config_.block_size = std::max<size_t>(1, config_.block_size);
+    config_.min_distance = std::max(1e-6, config_.min_distance);
+    
+    for (const auto& position : speaker_positions) {
+        double x, y, z;
+        toCartesian(position, x, y, z);
+        speaker_x_.push_back(x);
+        speaker_y_.push_back(y);
+        speaker_z_.push_back(z);
+    }
+    
+    size_t max_delay = static_cast<size_t>(std::ceil(config_.max_delay_seconds * config_.sample_rate));
+    history_length_ = nextPowerOfTwo(max_delay + config_.block_size + 4);
+    history_guard_ = config_.block_size + 4;
+    history_stride_ = history_length_ + history_guard_;
+}
+
+void MultichannelRenderer::setSources(const std::vector<QuantumSoundField>& fields) {
+    const size_t previous_count = voices_.size();
+    voices_.resize(fields.size());
+    history_.resize(fields.size() * history_stride_, 0.0f);
+    
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const QuantumSoundField& field = fields[i];
+        SourceVoice& voice = voices_[i];
+        double increment = 2.0 * M_PI * field.frequency / config_.sample_rate;
+        
+        voice.gain = field.amplitude * getQuantumStateFactor(field.quantum_state);
+        toCartesian(field.position, voice.x, voice.y, voice.z);
+        
+        if (i >= previous_count) {
+            // New voice starts at its own phase without a gain or position ramp
+            voice.oscillator.reset(field.phase, increment);
+            voice.previous_gain = voice.gain;
+            voice.previous_x = voice.x;
+            voice.previous_y = voice.y;
+            voice.previous_z = voice.z;
+        } else if (voice.frequency != field.frequency) {
+            // Phase-continuous frequency change
+            voice.oscillator.setPhaseIncrement(increment);
+        }
+        voice.frequency = field.frequency;
+    }
+}
+
+void MultichannelRenderer::renderBlock(std::vector<std::vector<float>>& output) {
+    const size_t block = config_.block_size;
+    
+    output.resize(speaker_x_.size());
+    for (auto& channel : output) {
+        channel.assign(block, 0.0f);
+    }
+    
+    if (voices_.empty()) {
+        write_position_ = (write_position_ + block) & (history_length_ - 1);
+        return;
+    }
+    
+    ThreadPool& pool = ThreadPool::shared();
+    
+    pool.parallelFor(voices_.size(), 16, [this](size_t begin, size_t end) {
+        synthesizeSources(begin, end);
+    });
+    
+    if (config_.room_response) {
+        pool.parallelFor(voices_.size(), 1, [this](size_t begin, size_t end) {
+            updateRoomTransfers(begin, end);
+        });
+    }
+    
+    pool.parallelFor(speaker_x_.size(), 1, [this, &output](size_t begin, size_t end) {
+        renderSpeakers(begin, end, output);
+    });
+    
+    for (auto& voice : voices_) {
+        voice.previous_gain = voice.gain;
+        voice.previous_x = voice.x;
+        voice.previous_y = voice.y;
+        voice.previous_z = voice.z;
+    }
+    
+    write_position_ = (write_position_ + block) & (history_length_ - 1);
+}
+
+void MultichannelRenderer::reset() {
+    voices_.clear();
+    history_.clear();
+    write_position_ = 0;
+}
+
+void MultichannelRenderer::synthesizeSources(size_t begin, size_t end) {
+    const size_t block = config_.block_size;
+    const size_t mask = history_length_ - 1;
+    const double inv_block = 1.0 / static_cast<double>(block);
+    
+    for (size_t v = begin; v < end; ++v) {
+        SourceVoice& voice = voices_[v];
+        float* line = &history_[v * history_stride_];
+        
+        // Gain ramps linearly across the block to avoid zipper noise
+        std::complex<double> gain_step = (voice.gain - voice.previous_gain) * inv_block;
+        std::complex<double> gain = voice.previous_gain;
+        
+        for (size_t n = 0; n < block; ++n) {
+            gain += gain_step;
+            double sample = gain.real() * voice.oscillator.real() - gain.imag() * voice.oscillator.imag();
+            size_t position = (write_position_ + n) & mask;
+            line[position] = static_cast<float>(sample);
+            if (position < history_guard_) {
+                line[position + history_length_] = static_cast<float>(sample);
+            }
+            voice.oscillator.advance();
+        }
+    }
+}
+
+void MultichannelRenderer::updateRoomTransfers(size_t begin, size_t end) {
+    RoomResponseCache& room = *config_.room_response;
+    const size_t speakers = speaker_x_.size();
+    
+    auto lookup_all = [&](const double position[3], std::vector<RoomTransfer>& transfers) {
+        transfers.resize(speakers);
+        for (size_t s = 0; s < speakers; ++s) {
+            const double speaker[3] = {speaker_x_[s], speaker_y_[s], speaker_z_[s]};
+            room.lookup(position, speaker, transfers[s]);
+        }
+    };
+    
+    for (size_t v = begin; v < end; ++v) {
+        SourceVoice& voice = voices_[v];
+        if (voice.room_valid && voice.room_x == voice.x && voice.room_y == voice.y && voice.room_z == voice.z) {
+            continue;
+        }
+        
+        // A moving voice ramps from the previous block's taps, which are usually the ones cached last block
+        const double previous_position[3] = {voice.previous_x, voice.previous_y, voice.previous_z};
+        const double position[3] = {voice.x, voice.y, voice.z};
+        const bool moving = previous_position[0] != position[0] || previous_position[1] != position[1] ||
+                            previous_position[2] != position[2];
+        if (moving) {
+            if (voice.room_valid && voice.room_x == previous_position[0] && voice.room_y == previous_position[1] &&
+                voice.room_z == previous_position[2]) {
+                voice.previous_room.swap(voice.room);
+            } else {
+                lookup_all(previous_position, voice.previous_room);
+            }
+        }
+        lookup_all(position, voice.room);
+        voice.room_x = position[0];
+        voice.room_y = position[1];
+        voice.room_z = position[2];
+        voice.room_valid = true;
+    }
+}
+
+void MultichannelRenderer::renderSpeakers(size_t begin, size_t end, std::vector<std::vector<float>>& output) const {
+    const size_t block = config_.block_size;
+    const size_t mask = history_length_ - 1;
+    const double samples_per_meter = config_.sample_rate / kSpeedOfSound;
+    const double max_delay = static_cast<double>(history_length_ - block - 4);
+    const double inv_block = 1.0 / static_cast<double>(block);
+    
+    auto delay_and_gain = [&](double dx, double dy, double dz, double& delay, double& gain) {
+        double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        delay = std::clamp(distance * samples_per_meter, kMinDelaySamples, max_delay);
+        gain = config_.reference_distance / std::max(distance, config_.min_distance);
+    };
+    
+    // One path read from a delay line: delay and gain interpolated across the block
+    auto render_path = [&](const float* line, double delay0, double delay1, double gain0, double gain1, float* out) {
+        double delay_step = (delay1 - delay0) * inv_block;
+        float gain_start = static_cast<float>(gain0);
+        float gain_step = static_cast<float>((gain1 - gain0) * inv_block);
+        
+        if (delay_step == 0.0) {
+            // Static path: fixed interpolation weights over contiguous samples
+            double read = static_cast<double>(write_position_ + history_length_) - delay0;
+            double integral = std::floor(read);
+            float wm1, w0, w1, w2;
+            hermiteWeights(static_cast<float>(read - integral), wm1, w0, w1, w2);
+            
+            const float* tap = line + ((static_cast<size_t>(integral) - 1) & mask);
+            for (size_t n = 0; n < block; ++n) {
+                float sample = wm1 * tap[n] + w0 * tap[n + 1] + w1 * tap[n + 2] + w2 * tap[n + 3];
+                out[n] += (gain_start + gain_step * static_cast<float>(n)) * sample;
+            }
+            return;
+        }
+        
+        for (size_t n = 0; n < block; ++n) {
+            double delay = delay0 + delay_step * n;
+            double read = static_cast<double>(write_position_ + history_length_ + n) - delay;
+            double integral = std::floor(read);
+            size_t i0 = static_cast<size_t>(integral);
+            float wm1, w0, w1, w2;
+            hermiteWeights(static_cast<float>(read - integral), wm1, w0, w1, w2);
+            
+            float sample = wm1 * line[(i0 - 1) & mask] + w0 * line[i0 & mask] +
+                           w1 * line[(i0 + 1) & mask] + w2 * line[(i0 + 2) & mask];
+            out[n] += (gain_start + gain_step * static_cast<float>(n)) * sample;
+        }
+    };
+    
+    for (size_t s = begin; s < end; ++s) {
+        float* out = output[s].data();
+        
+        for (size_t v = 0; v < voices_.size(); ++v) {
+            const SourceVoice& voice = voices_[v];
+            const float* line = &history_[v * history_stride_];
+            
+            // Delay and attenuation are interpolated across the block (Doppler for moving sources)
+            double delay0, gain0, delay1, gain1;
+            delay_and_gain(speaker_x_[s] - voice.previous_x, speaker_y_[s] - voice.previous_y,
+                           speaker_z_[s] - voice.previous_z, delay0, gain0);
+            delay_and_gain(speaker_x_[s] - voice.x, speaker_y_[s] - voice.y,
+                           speaker_z_[s] - voice.z, delay1, gain1);
+            render_path(line, delay0, delay1, gain0, gain1, out);
+            
+            if (!config_.room_response) {
+                continue;
+            }
+            
+            // Early reflections at the previous and current source positions; taps are
+            // ramped pairwise, or held at the current values when the reflection set changed
+            const RoomTransfer& transfer = voice.room[s];
+            const bool moving = voice.previous_x != voice.x || voice.previous_y != voice.y ||
+                                voice.previous_z != voice.z;
+            const RoomTransfer& previous_transfer = moving ? voice.previous_room[s] : transfer;
+            const bool paired = moving && previous_transfer.taps.size() == transfer.taps.size();
+            
+            for (size_t t = 0; t < transfer.taps.size(); ++t) {
+                const ReflectionTap& current = transfer.taps[t];
+                const ReflectionTap& start =
+                    paired && previous_transfer.taps[t].kind == current.kind ? previous_transfer.taps[t] : current;
+                double tap_delay0 = start.delay * config_.sample_rate;
+                double tap_delay1 = current.delay * config_.sample_rate;
+                if (std::max(tap_delay0, tap_delay1) > max_delay) {
+                    continue;
+                }
+                render_path(line, std::max(tap_delay0, kMinDelaySamples), std::max(tap_delay1, kMinDelaySamples),
+                            config_.reference_distance * start.gain, config_.reference_distance * current.gain, out);
+            }
+        }
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include "fast_math.hpp"
+#include "room_response_cache.hpp"
+#include <vector>
+#include <complex>
+
+namespace AnantaSound {
+
+// Параметры многоканального рендера
+struct RendererConfig {
+    double sample_rate;          // Частота дискретизации (Гц)
+    size_t block_size;           // Размер блока (отсчетов)
+    double max_delay_seconds;    // Максимальная задержка распространения (с)
+    double reference_distance;   // Расстояние с единичным усилением (м)
+    double min_distance;         // Ограничение 1/r вблизи динамика (м)
+    std::shared_ptr<RoomResponseCache> room_response;  // Ранние отражения купола; nullptr - только прямой путь
+    
+    RendererConfig() : sample_rate(48000.0), block_size(512), max_delay_seconds(0.1),
+                       reference_distance(1.0), min_distance(0.1) {}
+};
+
+// Рендер интерференционных полей в сигналы динамиков купола.
+// Каждый источник - осциллятор с фазовым аккумулятором (PhasorRotator),
+// чей выход пишется в линию задержки; каждый динамик читает линии
+// с дробной задержкой d/c и затуханием 1/r. Динамики рендерятся параллельно.
+// С room_response к прямому пути добавляются отводы ранних отражений из
+// кэша; отводы длиннее линии задержки отбрасываются. Отводы неподвижных
+// голосов запоминаются и не запрашиваются у кэша на каждом блоке.
+class MultichannelRenderer {
+private:
+    // Состояние голоса (источника) между блоками
+    struct SourceVoice {
+        PhasorRotator oscillator;
+        std::complex<double> gain;          // amplitude * quantum factor
+        std::complex<double> previous_gain; // для плавного перехода внутри блока
+        double frequency;
+        double x, y, z;                     // декартова позиция
+        double previous_x, previous_y, previous_z;
+        
+        // Отводы к каждому динамику в позиции room_x, room_y, room_z и в
+        // предыдущей позиции; кэш опрашивается только после сдвига голоса
+        std::vector<RoomTransfer> room;
+        std::vector<RoomTransfer> previous_room;
+        double room_x, room_y, room_z;
+        bool room_valid = false;
+    };
+    
+    RendererConfig config_;
+    std::vector<double> speaker_x_;
+    std::vector<double> speaker_y_;
+    std::vector<double> speaker_z_;
+    std::vector<SourceVoice> voices_;
+    
+    // Линии задержки: по кольцевому буферу history_length_ отсчетов на источник.
+    // За кольцом хранится копия его начала (history_guard_ отсчетов), чтобы
+    // чтение блока с постоянной задержкой шло по непрерывной памяти.
+    std::vector<float> history_;
+    size_t history_length_;
+    size_t history_guard_;
+    size_t history_stride_;
+    size_t write_position_;
+
+public:
+    MultichannelRenderer(const std::vector<SphericalCoord>& speaker_positions,
+                         const RendererConfig& config = RendererConfig());
+    
+    // Обновить набор источников; источники сопоставляются по индексу,
+    // фаза осцилляторов и содержимое линий задержки сохраняются
+    void setSources(const std::vector<QuantumSoundField>& fields);
+    
+    // Отрендерить следующий блок: output[speaker][sample]
+    void renderBlock(std::vector<std::vector<float>>& output);
+    
+    // Сбросить осцилляторы и линии задержки
+    void reset();
+    
+    size_t getSpeakerCount() const { return speaker_x_.size(); }
+    size_t getSourceCount() const { return voices_.size(); }
+    const RendererConfig& getConfig() const { return config_; }
+
+private:
+    void synthesizeSources(size_t begin, size_t end);
+    void updateRoomTransfers(size_t begin, size_t end);
+    void renderSpeakers(size_t begin, size_t end, std::vector<std::vector<float>>& output) const;
+};
+
+} // namespace AnantaSound
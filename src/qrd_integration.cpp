@@ -119,12 +119,19 @@ void QRDIntegration::updateQRDField(double resonance_strength, double dt) {
 }
 
 std::vector<QuantumSoundField> QRDIntegration::generateResonanceFields(const SphericalCoord& position, size_t count) const {
+    std::vector<QuantumSoundField> resonance_fields;
+    resonance_fields.reserve(qrd_active_ ? count : 0);
+    generateResonanceFields(position, count, resonance_fields);
+    return resonance_fields;
+}
+
+size_t QRDIntegration::generateResonanceFields(const SphericalCoord& position, size_t count,
+                                               std::vector<QuantumSoundField>& out) const {
     if (!qrd_active_) {
-        return {};
+        return 0;
     }
     
-    std::vector<QuantumSoundField> resonance_fields;
-    resonance_fields.reserve(count);
+    const auto timestamp = std::chrono::high_resolution_clock::now();
     
     // Generate harmonically related resonance fields
     for (size_t i = 0; i < count; ++i) {
@@ -144,12 +151,12 @@ std::vector<QuantumSoundField> QRDIntegration::generateResonanceFields(const Sph
         field.frequency = harmonic_freq;
         field.quantum_state = qrd_field_.quantum_state;
         field.position = position;
-        field.timestamp = std::chrono::high_resolution_clock::now();
+        field.timestamp = timestamp;
         
-        resonance_fields.push_back(field);
+        out.push_back(field);
     }
     
-    return resonance_fields;
+    return count;
 }
 
 void QRDIntegration::createQuantumEntanglement(const std::vector<QuantumSoundField>& fields) {
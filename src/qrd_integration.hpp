@@ -32,6 +32,9 @@ public:
     
     // Field Generation
     std::vector<QuantumSoundField> generateResonanceFields(const SphericalCoord& position, size_t count) const;
+    // Appends into out (e.g. FieldArena::buffer()); returns the number of fields
+    size_t generateResonanceFields(const SphericalCoord& position, size_t count,
+                                   std::vector<QuantumSoundField>& out) const;
     
     // Quantum Entanglement
     void createQuantumEntanglement(const std::vector<QuantumSoundField>& fields);
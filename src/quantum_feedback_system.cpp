@@ -1,14 +1,91 @@
 #include "quantum_feedback_system.hpp"
+#include "thread_pool.hpp"
 #include <cmath>
-#include <random>
 #include <algorithm>
+#include <limits>
 
 namespace AnantaSound {
 
+namespace {
+
+// Independent accumulator lanes let the compiler vectorize the reduction over M
+constexpr size_t kFeedbackLanes = 4;
+
+// Feedback fields per block; the correlation scratch stays in L1
+constexpr size_t kFeedbackBlockSize = 256;
+
+// Input/feedback pair count below which the batch stays on the calling thread
+constexpr size_t kParallelFeedbackThreshold = 1 << 14;
+
+// Inputs per parallel task
+constexpr size_t kFeedbackGrain = 16;
+
+// Width of the frequency-correlation kernel 1 / (1 + |df| / kFrequencyCorrelationScale)
+constexpr double kFrequencyCorrelationScale = 1000.0;
+
+// Headroom on the exact cut-off for phase terms computed with MathAccuracy::FAST
+constexpr double kCullSlack = 1e-4;
+
+// Half-width (Hz) beyond which a pair cannot pass the correlation threshold:
+// phase and state terms are at most 1, so the frequency term must exceed 3t - 2
+double exactCorrelationRadius(double threshold) {
+    const double min_frequency_term = 3.0 * threshold - 2.0 - kCullSlack;
+    if (min_frequency_term >= 1.0) {
+        return -1.0;
+    }
+    if (min_frequency_term <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return kFrequencyCorrelationScale * (1.0 / min_frequency_term - 1.0);
+}
+
+// Sliding DFT bins per watched frequency: offsets -2..+2 bins, combined
+// into Hann-windowed values at -1, 0, +1
+constexpr size_t kBinsPerWatch = 5;
+
+// Sliding bins are recomputed from the history this often (samples) so
+// rounding in the recursion cannot build up over long streams
+constexpr size_t kResyncInterval = size_t(1) << 20;
+
+// Half-power level below a peak (dB)
+constexpr double kHalfPowerDb = 3.0102999566398120;
+
+// Parabolic fit of three dB levels one bin apart around a local maximum:
+// peak offset (bins), peak level (dB) and -3 dB half-width (bins)
+void refinePeak(double left, double center, double right,
+                double& offset, double& level_db, double& half_width) {
+    auto to_db = [](double magnitude) { return 20.0 * std::log10(std::max(magnitude, 1e-300)); };
+    const double l = to_db(left);
+    const double c = to_db(center);
+    const double r = to_db(right);
+    const double curvature = l - 2.0 * c + r;
+    if (curvature >= 0.0) {
+        offset = 0.0;
+        level_db = c;
+        half_width = std::numeric_limits<double>::infinity();
+        return;
+    }
+    offset = std::clamp(0.5 * (l - r) / curvature, -1.0, 1.0);
+    level_db = c - 0.25 * (l - r) * offset;
+    half_width = std::sqrt(kHalfPowerDb / (-0.5 * curvature));
+}
+
+// Phase-locked loop: largest ω_n * h per integration sub-step, and the
+// number of incremental reference updates between exact recomputations
+constexpr double kMaxLoopStep = 0.1;
+constexpr size_t kReferenceRecomputeInterval = 4096;
+
+inline double wrapPhase(double phase) {
+    return phase - 2.0 * M_PI * std::nearbyint(phase / (2.0 * M_PI));
+}
+
+} // namespace
+
 // QuantumFeedbackSystem implementation
 QuantumFeedbackSystem::QuantumFeedbackSystem(double feedback_gain, double quantum_threshold)
     : feedback_gain_(feedback_gain), quantum_threshold_(quantum_threshold), 
-      feedback_enabled_(true), quantum_mode_(true) {
+      feedback_enabled_(true), quantum_mode_(true), math_accuracy_(getDefaultMathAccuracy()),
+      correlation_bandwidth_(0.0), last_error_bound_(0.0) {
 }
 
 void QuantumFeedbackSystem::setFeedbackGain(double gain) {
@@ -35,6 +112,22 @@ void QuantumFeedbackSystem::setQuantumMode(bool enabled) {
     quantum_mode_ = enabled;
 }
 
+void QuantumFeedbackSystem::setMathAccuracy(MathAccuracy accuracy) {
+    math_accuracy_ = accuracy;
+}
+
+void QuantumFeedbackSystem::setCorrelationBandwidth(double bandwidth_hz) {
+    correlation_bandwidth_ = std::max(bandwidth_hz, 0.0);
+}
+
+double QuantumFeedbackSystem::getCorrelationBandwidth() const {
+    return correlation_bandwidth_;
+}
+
+double QuantumFeedbackSystem::getLastFeedbackErrorBound() const {
+    return last_error_bound_;
+}
+
 QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField& input_field, 
                                                        const std::vector<QuantumSoundField>& feedback_fields) {
     if (!feedback_enabled_) {
@@ -54,7 +147,7 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
             if (correlation > quantum_threshold_) {
                 // Apply quantum feedback
                 std::complex<double> feedback_contribution = fb_field.amplitude * 
-                    std::exp(std::complex<double>(0.0, fb_field.phase));
+                    fastExpI(fb_field.phase, math_accuracy_);
                 
                 quantum_feedback += feedback_contribution * correlation;
             }
@@ -73,7 +166,7 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
         
         for (const auto& fb_field : feedback_fields) {
             classical_feedback += fb_field.amplitude * 
-                std::exp(std::complex<double>(0.0, fb_field.phase));
+                fastExpI(fb_field.phase, math_accuracy_);
         }
         
         // Apply classical feedback
@@ -83,6 +176,152 @@ QuantumSoundField QuantumFeedbackSystem::processFeedback(const QuantumSoundField
     return output_field;
 }
 
+std::vector<QuantumSoundField> QuantumFeedbackSystem::processFeedbackBatch(
+    const std::vector<QuantumSoundField>& input_fields, const std::vector<QuantumSoundField>& feedback_fields) {
+    std::vector<QuantumSoundField> output_fields = input_fields;
+    last_error_bound_ = 0.0;
+    if (!feedback_enabled_ || input_fields.empty()) {
+        return output_fields;
+    }
+    
+    if (!quantum_mode_ || feedback_fields.empty()) {
+        // Classical feedback does not depend on the input: summed once for the batch
+        std::complex<double> classical_feedback(0.0, 0.0);
+        for (const auto& fb_field : feedback_fields) {
+            classical_feedback += fb_field.amplitude * fastExpI(fb_field.phase, math_accuracy_);
+        }
+        for (auto& field : output_fields) {
+            field.amplitude += classical_feedback * feedback_gain_;
+        }
+        return output_fields;
+    }
+    
+    feedback_store_.assign(feedback_fields, math_accuracy_);
+    
+    // Pairs outside the exact radius are masked anyway; a narrower user
+    // bandwidth skips pairs that could pass and is reported as an error bound
+    const double exact_radius = exactCorrelationRadius(quantum_threshold_);
+    double half_width = exact_radius;
+    double skipped_correlation = 0.0;
+    if (correlation_bandwidth_ > 0.0 && correlation_bandwidth_ < exact_radius) {
+        half_width = correlation_bandwidth_;
+        skipped_correlation = std::min((2.0 + 1.0 / (1.0 + half_width / kFrequencyCorrelationScale)) / 3.0, 1.0);
+    }
+    
+    std::vector<double> error_bounds(input_fields.size(), 0.0);
+    auto process_range = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto band = feedback_store_.index.range(input_fields[i].frequency, half_width);
+            std::complex<double> quantum_feedback = accumulateQuantumFeedback(input_fields[i], band.first, band.second);
+            output_fields[i].amplitude += quantum_feedback * feedback_gain_;
+            if (std::abs(quantum_feedback.real()) > quantum_threshold_) {
+                output_fields[i].quantum_state = QuantumSoundState::ENTANGLED;
+            }
+            error_bounds[i] = skipped_correlation * feedback_store_.index.weightOutside(band.first, band.second);
+        }
+    };
+    
+    if (input_fields.size() * feedback_store_.size() < kParallelFeedbackThreshold) {
+        process_range(0, input_fields.size());
+    } else {
+        ThreadPool::shared().parallelFor(input_fields.size(), kFeedbackGrain, process_range);
+    }
+    
+    last_error_bound_ = feedback_gain_ * *std::max_element(error_bounds.begin(), error_bounds.end());
+    return output_fields;
+}
+
+void QuantumFeedbackSystem::FeedbackFieldStore::assign(const std::vector<QuantumSoundField>& fields,
+                                                       MathAccuracy accuracy) {
+    const size_t count = fields.size();
+    
+    // Index over frequency with |amplitude| weights, then the SoA in sorted order
+    frequency.resize(count);
+    scratch.resize(count);
+    for (size_t j = 0; j < count; ++j) {
+        frequency[j] = fields[j].frequency;
+        scratch[j] = std::abs(fields[j].amplitude);
+    }
+    index.build(frequency.data(), count, scratch.data());
+    
+    cos_phase.resize(count);
+    sin_phase.resize(count);
+    contribution_re.resize(count);
+    contribution_im.resize(count);
+    state.resize(count);
+    
+    const std::vector<size_t>& order = index.order();
+    for (size_t j = 0; j < count; ++j) {
+        const QuantumSoundField& field = fields[order[j]];
+        fastSinCos(field.phase, sin_phase[j], cos_phase[j], accuracy);
+        frequency[j] = field.frequency;
+        std::complex<double> contribution = field.amplitude * fastExpI(field.phase, accuracy);
+        contribution_re[j] = contribution.real();
+        contribution_im[j] = contribution.imag();
+        state[j] = static_cast<double>(field.quantum_state);
+    }
+}
+
+std::complex<double> QuantumFeedbackSystem::accumulateQuantumFeedback(const QuantumSoundField& input_field,
+                                                                      size_t range_begin, size_t range_end) const {
+    // Same terms as calculateQuantumCorrelation: cos|Δφ| is expanded as
+    // cos φ1 cos φ2 + sin φ1 sin φ2, and the 0.7 state branch there needs
+    // equal states, so it reduces to 1.0 (equal) or 0.3 (different)
+    double input_sin, input_cos;
+    fastSinCos(input_field.phase, input_sin, input_cos, math_accuracy_);
+    const double input_frequency = input_field.frequency;
+    const double input_state = static_cast<double>(input_field.quantum_state);
+    const double threshold = quantum_threshold_;
+    
+    const size_t count = range_end - range_begin;
+    const double* cos_phase = feedback_store_.cos_phase.data() + range_begin;
+    const double* sin_phase = feedback_store_.sin_phase.data() + range_begin;
+    const double* frequency = feedback_store_.frequency.data() + range_begin;
+    const double* contribution_re = feedback_store_.contribution_re.data() + range_begin;
+    const double* contribution_im = feedback_store_.contribution_im.data() + range_begin;
+    const double* state = feedback_store_.state.data() + range_begin;
+    
+    double correlation[kFeedbackBlockSize];
+    double acc_re[kFeedbackLanes] = {};
+    double acc_im[kFeedbackLanes] = {};
+    
+    for (size_t begin = 0; begin < count; begin += kFeedbackBlockSize) {
+        const size_t n = std::min(kFeedbackBlockSize, count - begin);
+        
+        // Branch-free correlations; pairs at or below the threshold are masked to zero
+        for (size_t j = 0; j < n; ++j) {
+            const size_t k = begin + j;
+            double phase_corr = input_cos * cos_phase[k] + input_sin * sin_phase[k];
+            double freq_corr = 1.0 / (1.0 + std::abs(input_frequency - frequency[k]) / kFrequencyCorrelationScale);
+            double state_corr = state[k] == input_state ? 1.0 : 0.3;
+            double value = std::min(std::max((phase_corr + freq_corr + state_corr) / 3.0, 0.0), 1.0);
+            correlation[j] = value > threshold ? value : 0.0;
+        }
+        
+        const double* cre = contribution_re + begin;
+        const double* cim = contribution_im + begin;
+        size_t j = 0;
+        for (; j + kFeedbackLanes <= n; j += kFeedbackLanes) {
+            for (size_t l = 0; l < kFeedbackLanes; ++l) {
+                acc_re[l] += correlation[j + l] * cre[j + l];
+                acc_im[l] += correlation[j + l] * cim[j + l];
+            }
+        }
+        for (; j < n; ++j) {
+            acc_re[0] += correlation[j] * cre[j];
+            acc_im[0] += correlation[j] * cim[j];
+        }
+    }
+    
+    double total_re = 0.0;
+    double total_im = 0.0;
+    for (size_t l = 0; l < kFeedbackLanes; ++l) {
+        total_re += acc_re[l];
+        total_im += acc_im[l];
+    }
+    return std::complex<double>(total_re, total_im);
+}
+
 double QuantumFeedbackSystem::calculateQuantumCorrelation(const QuantumSoundField& field1, 
                                                         const QuantumSoundField& field2) const {
     // Calculate quantum correlation based on state similarity
@@ -90,11 +329,11 @@ double QuantumFeedbackSystem::calculateQuantumCorrelation(const QuantumSoundFiel
     
     // Phase correlation
     double phase_diff = std::abs(field1.phase - field2.phase);
-    double phase_corr = std::cos(phase_diff);
+    double phase_corr = fastCos(phase_diff, math_accuracy_);
     
     // Frequency correlation
     double freq_diff = std::abs(field1.frequency - field2.frequency);
-    double freq_corr = 1.0 / (1.0 + freq_diff / 1000.0); // Normalize to reasonable range
+    double freq_corr = 1.0 / (1.0 + freq_diff / kFrequencyCorrelationScale); // Normalize to reasonable range
     
     // Quantum state correlation
     double state_corr = 0.0;
@@ -118,36 +357,43 @@ double QuantumFeedbackSystem::calculateQuantumCorrelation(const QuantumSoundFiel
 std::vector<QuantumSoundField> QuantumFeedbackSystem::generateQuantumFeedback(const QuantumSoundField& input_field, 
                                                                              size_t feedback_count) {
     std::vector<QuantumSoundField> feedback_fields;
-    
+    feedback_fields.reserve(quantum_mode_ ? feedback_count : 0);
+    generateQuantumFeedback(input_field, feedback_count, feedback_fields);
+    return feedback_fields;
+}
+
+size_t QuantumFeedbackSystem::generateQuantumFeedback(const QuantumSoundField& input_field, size_t feedback_count,
+                                                      std::vector<QuantumSoundField>& out) {
     if (!quantum_mode_) {
-        return feedback_fields;
+        return 0;
     }
     
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::normal_distribution<double> noise(0.0, 0.1);
+    // Five N(0, 0.1) draws per feedback field, generated as one batch
+    noise_buffer_.resize(5 * feedback_count);
+    random_.fillNormal(noise_buffer_.data(), noise_buffer_.size(), 0.0, 0.1);
     
     for (size_t i = 0; i < feedback_count; ++i) {
         QuantumSoundField feedback_field = input_field;
+        const double* noise = &noise_buffer_[5 * i];
         
         // Add quantum noise
-        feedback_field.amplitude += std::complex<double>(noise(gen), noise(gen));
+        feedback_field.amplitude += std::complex<double>(noise[0], noise[1]);
         
         // Slight frequency variation
-        feedback_field.frequency += noise(gen) * 10.0;
+        feedback_field.frequency += noise[2] * 10.0;
         
         // Phase shift
-        feedback_field.phase += noise(gen) * M_PI / 8.0;
+        feedback_field.phase += noise[3] * M_PI / 8.0;
         
         // Quantum state variation
-        if (noise(gen) > 0.5) {
+        if (noise[4] > 0.5) {
             feedback_field.quantum_state = QuantumSoundState::SUPERPOSITION;
         }
         
-        feedback_fields.push_back(feedback_field);
+        out.push_back(feedback_field);
     }
     
-    return feedback_fields;
+    return feedback_count;
 }
 
 void QuantumFeedbackSystem::resetFeedback() {
@@ -158,7 +404,9 @@ void QuantumFeedbackSystem::resetFeedback() {
 
 // QuantumResonanceDetector implementation
 QuantumResonanceDetector::QuantumResonanceDetector(double resonance_threshold)
-    : resonance_threshold_(resonance_threshold), detection_enabled_(true) {
+    : resonance_threshold_(resonance_threshold), detection_enabled_(true),
+      stream_sample_rate_(0.0), window_size_(0), stream_threshold_(1e-3),
+      history_position_(0), samples_seen_(0), samples_since_resync_(0) {
 }
 
 void QuantumResonanceDetector::setResonanceThreshold(double threshold) {
@@ -214,9 +462,204 @@ std::vector<double> QuantumResonanceDetector::findResonantFrequencies(const std:
     return resonant_frequencies;
 }
 
+void QuantumResonanceDetector::configureStream(double sample_rate, size_t window_size) {
+    stream_sample_rate_ = sample_rate;
+    window_size_ = 1;
+    while (window_size_ < std::max<size_t>(window_size, 16)) {
+        window_size_ <<= 1;
+    }
+    analyzer_ = std::make_unique<AudioAnalyzer>(window_size_, static_cast<size_t>(sample_rate));
+    history_.assign(window_size_, 0.0f);
+    const std::vector<double> watched = watched_frequencies_;
+    setWatchedFrequencies(watched);
+    resetStream();
+}
+
+void QuantumResonanceDetector::setWatchedFrequencies(const std::vector<double>& frequencies) {
+    watched_frequencies_.clear();
+    bin_re_.clear();
+    bin_im_.clear();
+    rotation_re_.clear();
+    rotation_im_.clear();
+    entry_re_.clear();
+    entry_im_.clear();
+    if (window_size_ == 0) {
+        watched_frequencies_ = frequencies;
+        return;
+    }
+    
+    // Every watched frequency needs its side bins inside (0, Nyquist)
+    const double bin_width = stream_sample_rate_ / static_cast<double>(window_size_);
+    const double window = static_cast<double>(window_size_);
+    for (double frequency : frequencies) {
+        if (frequency - 2.0 * bin_width <= 0.0 || frequency + 2.0 * bin_width >= 0.5 * stream_sample_rate_) {
+            continue;
+        }
+        watched_frequencies_.push_back(frequency);
+        for (int offset = -2; offset <= 2; ++offset) {
+            const double omega = 2.0 * M_PI * (frequency + offset * bin_width) / stream_sample_rate_;
+            rotation_re_.push_back(std::cos(omega));
+            rotation_im_.push_back(std::sin(omega));
+            entry_re_.push_back(std::cos(omega * (window - 1.0)));
+            entry_im_.push_back(-std::sin(omega * (window - 1.0)));
+        }
+    }
+    bin_re_.assign(rotation_re_.size(), 0.0);
+    bin_im_.assign(rotation_re_.size(), 0.0);
+    resyncBins();
+}
+
+void QuantumResonanceDetector::setStreamThreshold(double amplitude) {
+    stream_threshold_ = std::max(amplitude, 0.0);
+}
+
+void QuantumResonanceDetector::processAudio(const float* samples, size_t count) {
+    if (window_size_ == 0) {
+        return;
+    }
+    
+    const size_t mask = window_size_ - 1;
+    const size_t bins = bin_re_.size();
+    double* bin_re = bin_re_.data();
+    double* bin_im = bin_im_.data();
+    const double* rotation_re = rotation_re_.data();
+    const double* rotation_im = rotation_im_.data();
+    const double* entry_re = entry_re_.data();
+    const double* entry_im = entry_im_.data();
+    
+    for (size_t n = 0; n < count; ++n) {
+        const double incoming = samples[n];
+        const double outgoing = history_[history_position_];
+        history_[history_position_] = samples[n];
+        history_position_ = (history_position_ + 1) & mask;
+        
+        // X <- e^{iω} (X - x_out) + x_in e^{-iω(N-1)}, all bins at once
+        for (size_t k = 0; k < bins; ++k) {
+            const double re = bin_re[k] - outgoing;
+            const double im = bin_im[k];
+            bin_re[k] = rotation_re[k] * re - rotation_im[k] * im + incoming * entry_re[k];
+            bin_im[k] = rotation_re[k] * im + rotation_im[k] * re + incoming * entry_im[k];
+        }
+    }
+    
+    samples_seen_ += count;
+    samples_since_resync_ += count;
+    if (samples_since_resync_ >= kResyncInterval) {
+        resyncBins();
+    }
+}
+
+std::vector<ResonancePeak> QuantumResonanceDetector::getWatchedPeaks() const {
+    std::vector<ResonancePeak> peaks;
+    if (!detection_enabled_ || !isStreamReady()) {
+        return peaks;
+    }
+    
+    const double window = static_cast<double>(window_size_);
+    const double bin_width = stream_sample_rate_ / window;
+    for (size_t w = 0; w < watched_frequencies_.size(); ++w) {
+        const size_t base = w * kBinsPerWatch;
+        
+        // Hann window in the frequency domain: 0.5 X(m) - 0.25 X(m - 1) - 0.25 X(m + 1)
+        double magnitude[3];
+        for (size_t m = 0; m < 3; ++m) {
+            const size_t k = base + m + 1;
+            const double re = 0.5 * bin_re_[k] - 0.25 * (bin_re_[k - 1] + bin_re_[k + 1]);
+            const double im = 0.5 * bin_im_[k] - 0.25 * (bin_im_[k - 1] + bin_im_[k + 1]);
+            magnitude[m] = std::hypot(re, im);
+        }
+        if (magnitude[1] < magnitude[0] || magnitude[1] < magnitude[2]) {
+            continue;
+        }
+        
+        double offset, level_db, half_width;
+        refinePeak(magnitude[0], magnitude[1], magnitude[2], offset, level_db, half_width);
+        
+        // A sinusoid of amplitude A gives a Hann-windowed magnitude of A N / 4
+        const double amplitude = 4.0 * std::pow(10.0, level_db / 20.0) / window;
+        if (amplitude < stream_threshold_) {
+            continue;
+        }
+        const double frequency = watched_frequencies_[w] + offset * bin_width;
+        peaks.push_back({frequency, amplitude, frequency / (2.0 * half_width * bin_width), true});
+    }
+    return peaks;
+}
+
+std::vector<ResonancePeak> QuantumResonanceDetector::searchResonantPeaks(size_t max_peaks) {
+    std::vector<ResonancePeak> peaks;
+    if (!detection_enabled_ || !isStreamReady()) {
+        return peaks;
+    }
+    
+    // Last window in chronological order through the analyzer's Hann STFT
+    std::vector<double> window_samples(window_size_);
+    for (size_t i = 0; i < window_size_; ++i) {
+        window_samples[i] = history_[(history_position_ + i) & (window_size_ - 1)];
+    }
+    const std::vector<double> magnitude = analyzer_->analyzeAudio(window_samples).magnitude_spectrum;
+    
+    const double window = static_cast<double>(window_size_);
+    const double bin_width = stream_sample_rate_ / window;
+    for (size_t bin = 1; bin + 1 < magnitude.size(); ++bin) {
+        if (magnitude[bin] < magnitude[bin - 1] || magnitude[bin] <= magnitude[bin + 1]) {
+            continue;
+        }
+        double offset, level_db, half_width;
+        refinePeak(magnitude[bin - 1], magnitude[bin], magnitude[bin + 1], offset, level_db, half_width);
+        const double amplitude = 4.0 * std::pow(10.0, level_db / 20.0) / window;
+        if (amplitude < stream_threshold_) {
+            continue;
+        }
+        const double frequency = (bin + offset) * bin_width;
+        peaks.push_back({frequency, amplitude, frequency / (2.0 * half_width * bin_width), false});
+    }
+    
+    std::sort(peaks.begin(), peaks.end(),
+              [](const ResonancePeak& a, const ResonancePeak& b) { return a.amplitude > b.amplitude; });
+    if (peaks.size() > max_peaks) {
+        peaks.resize(max_peaks);
+    }
+    return peaks;
+}
+
+void QuantumResonanceDetector::resetStream() {
+    std::fill(history_.begin(), history_.end(), 0.0f);
+    std::fill(bin_re_.begin(), bin_re_.end(), 0.0);
+    std::fill(bin_im_.begin(), bin_im_.end(), 0.0);
+    history_position_ = 0;
+    samples_seen_ = 0;
+    samples_since_resync_ = 0;
+}
+
+void QuantumResonanceDetector::resyncBins() {
+    samples_since_resync_ = 0;
+    if (window_size_ == 0) {
+        return;
+    }
+    
+    // X = Σ x_j e^{-iωj} over the window, oldest sample first
+    const size_t mask = window_size_ - 1;
+    for (size_t k = 0; k < bin_re_.size(); ++k) {
+        const std::complex<double> step(rotation_re_[k], -rotation_im_[k]);
+        std::complex<double> twiddle(1.0, 0.0);
+        std::complex<double> sum(0.0, 0.0);
+        for (size_t j = 0; j < window_size_; ++j) {
+            sum += static_cast<double>(history_[(history_position_ + j) & mask]) * twiddle;
+            twiddle *= step;
+        }
+        bin_re_[k] = sum.real();
+        bin_im_[k] = sum.imag();
+    }
+}
+
 // QuantumPhaseSynchronizer implementation
 QuantumPhaseSynchronizer::QuantumPhaseSynchronizer(double sync_tolerance)
-    : sync_tolerance_(sync_tolerance), sync_enabled_(true) {
+    : sync_tolerance_(sync_tolerance), sync_enabled_(true),
+      loop_bandwidth_(2.0), damping_(M_SQRT1_2), lock_threshold_(0.01),
+      coherent_sin_(0.0), coherent_cos_(0.0), coherent_count_(0),
+      all_sin_(0.0), all_cos_(0.0), updates_since_recompute_(0),
+      reference_phase_(0.0), settled_reference_(0.0) {
 }
 
 void QuantumPhaseSynchronizer::setSyncTolerance(double tolerance) {
@@ -232,37 +675,41 @@ void QuantumPhaseSynchronizer::setSyncEnabled(bool enabled) {
 }
 
 std::vector<QuantumSoundField> QuantumPhaseSynchronizer::synchronizePhases(const std::vector<QuantumSoundField>& fields) const {
+    std::vector<QuantumSoundField> synchronized_fields = fields;
+    synchronizePhasesInPlace(synchronized_fields);
+    return synchronized_fields;
+}
+
+void QuantumPhaseSynchronizer::synchronizePhasesInPlace(std::vector<QuantumSoundField>& fields) const {
     if (!sync_enabled_ || fields.empty()) {
-        return fields;
+        return;
     }
     
-    std::vector<QuantumSoundField> synchronized_fields = fields;
-    
-    // Find reference phase (average of coherent fields)
-    double reference_phase = 0.0;
+    // Reference phase: circular mean of coherent fields, so phases on both
+    // sides of ±π average to π rather than to 0
+    double sum_sin = 0.0;
+    double sum_cos = 0.0;
     int coherent_count = 0;
     
     for (const auto& field : fields) {
         if (field.quantum_state == QuantumSoundState::COHERENT) {
-            reference_phase += field.phase;
+            sum_sin += std::sin(field.phase);
+            sum_cos += std::cos(field.phase);
             coherent_count++;
         }
     }
     
-    if (coherent_count > 0) {
-        reference_phase /= coherent_count;
+    double reference_phase;
+    if (coherent_count > 0 && std::hypot(sum_sin, sum_cos) > 1e-12 * coherent_count) {
+        reference_phase = std::atan2(sum_sin, sum_cos);
     } else {
-        // Use first field as reference if no coherent fields
+        // Use first field as reference if no coherent fields (or they cancel out)
         reference_phase = fields[0].phase;
     }
     
     // Synchronize all fields to reference phase
-    for (auto& field : synchronized_fields) {
-        double phase_diff = field.phase - reference_phase;
-        
-        // Normalize phase difference to [-π, π]
-        while (phase_diff > M_PI) phase_diff -= 2.0 * M_PI;
-        while (phase_diff < -M_PI) phase_diff += 2.0 * M_PI;
+    for (auto& field : fields) {
+        double phase_diff = wrapPhase(field.phase - reference_phase);
         
         // Apply phase correction if within tolerance
         if (std::abs(phase_diff) > sync_tolerance_) {
@@ -274,8 +721,193 @@ std::vector<QuantumSoundField> QuantumPhaseSynchronizer::synchronizePhases(const
             }
         }
     }
+}
+
+void QuantumPhaseSynchronizer::setLoopBandwidth(double bandwidth_hz) {
+    loop_bandwidth_ = std::max(bandwidth_hz, 1e-3);
+}
+
+void QuantumPhaseSynchronizer::setDampingFactor(double damping) {
+    damping_ = std::clamp(damping, 0.1, 4.0);
+}
+
+void QuantumPhaseSynchronizer::setLockThreshold(double radians) {
+    lock_threshold_ = std::clamp(radians, 1e-6, M_PI);
+}
+
+QuantumPhaseSynchronizer::ChannelId QuantumPhaseSynchronizer::attachField(const QuantumSoundField& field) {
+    PllChannel channel;
+    channel.field = field;
+    channel.output_phase = wrapPhase(field.phase);
+    channel.output_state = field.quantum_state;
+    channel.frequency_offset = 0.0;
+    channel.error_average = M_PI;
+    channel.locked = false;
+    channel.active = false;
     
-    return synchronized_fields;
+    const ChannelId id = channels_.insert(channel);
+    addToReference(field, 1.0);
+    activate(id, *channels_.get(id));
+    return id;
+}
+
+bool QuantumPhaseSynchronizer::detachField(ChannelId id) {
+    const PllChannel* channel = channels_.get(id);
+    if (!channel) {
+        return false;
+    }
+    addToReference(channel->field, -1.0);
+    // A stale entry in active_channels_ is dropped by the next tick
+    return channels_.erase(id);
+}
+
+bool QuantumPhaseSynchronizer::updateField(ChannelId id, const QuantumSoundField& field) {
+    PllChannel* channel = channels_.get(id);
+    if (!channel) {
+        return false;
+    }
+    addToReference(channel->field, -1.0);
+    addToReference(field, 1.0);
+    channel->field = field;
+    if (field.quantum_state != QuantumSoundState::SUPERPOSITION || !channel->locked) {
+        channel->output_state = field.quantum_state;
+    }
+    channel->locked = false;
+    activate(id, *channel);
+    return true;
+}
+
+size_t QuantumPhaseSynchronizer::tick(double dt) {
+    changed_channels_.clear();
+    if (!sync_enabled_ || dt <= 0.0 || channels_.empty()) {
+        return 0;
+    }
+    
+    // Exact sums now and then so add/subtract rounding cannot accumulate
+    if (updates_since_recompute_ >= kReferenceRecomputeInterval) {
+        recomputeReference();
+    }
+    updateReferencePhase();
+    
+    // Locked channels are left alone until the reference drifts past the lock threshold
+    if (std::abs(wrapPhase(reference_phase_ - settled_reference_)) > lock_threshold_) {
+        for (size_t i = 0; i < channels_.size(); ++i) {
+            activate(channels_.handleAt(i), channels_.values()[i]);
+        }
+        settled_reference_ = reference_phase_;
+    }
+    
+    // Type II loop: ω_n = 2π B, K_p = 2ζω_n, K_i = ω_n²; long ticks are split
+    // into sub-steps so the discrete loop stays stable
+    const double omega_n = 2.0 * M_PI * loop_bandwidth_;
+    const double proportional_gain = 2.0 * damping_ * omega_n;
+    const double integral_gain = omega_n * omega_n;
+    const int steps = std::max(1, static_cast<int>(std::ceil(dt * omega_n / kMaxLoopStep)));
+    const double h = dt / steps;
+    const double averaging = 1.0 - std::exp(-dt * omega_n);
+    
+    size_t processed = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < active_channels_.size(); ++i) {
+        const ChannelId id = active_channels_[i];
+        PllChannel* channel = channels_.get(id);
+        if (!channel) {
+            continue;
+        }
+        ++processed;
+        
+        for (int step = 0; step < steps; ++step) {
+            double error = wrapPhase(reference_phase_ - channel->output_phase);
+            channel->frequency_offset += integral_gain * error * h;
+            channel->output_phase = wrapPhase(channel->output_phase +
+                                              (proportional_gain * error + channel->frequency_offset) * h);
+        }
+        
+        double error = std::abs(wrapPhase(reference_phase_ - channel->output_phase));
+        channel->error_average += averaging * (error - channel->error_average);
+        changed_channels_.push_back(id);
+        
+        if (channel->error_average < lock_threshold_) {
+            channel->locked = true;
+            channel->active = false;
+            channel->frequency_offset = 0.0;
+            if (channel->output_state == QuantumSoundState::SUPERPOSITION) {
+                channel->output_state = QuantumSoundState::COHERENT;
+            }
+        } else {
+            active_channels_[kept++] = id;
+        }
+    }
+    active_channels_.resize(kept);
+    
+    return processed;
+}
+
+bool QuantumPhaseSynchronizer::getSynchronizedField(ChannelId id, QuantumSoundField& field) const {
+    const PllChannel* channel = channels_.get(id);
+    if (!channel) {
+        return false;
+    }
+    field = channel->field;
+    field.phase = channel->output_phase;
+    field.quantum_state = channel->output_state;
+    return true;
+}
+
+bool QuantumPhaseSynchronizer::isLocked(ChannelId id) const {
+    const PllChannel* channel = channels_.get(id);
+    return channel && channel->locked;
+}
+
+void QuantumPhaseSynchronizer::addToReference(const QuantumSoundField& field, double sign) {
+    const double s = sign * std::sin(field.phase);
+    const double c = sign * std::cos(field.phase);
+    all_sin_ += s;
+    all_cos_ += c;
+    if (field.quantum_state == QuantumSoundState::COHERENT) {
+        coherent_sin_ += s;
+        coherent_cos_ += c;
+        coherent_count_ = sign > 0.0 ? coherent_count_ + 1 : coherent_count_ - 1;
+    }
+    // The exact recomputation waits for tick(): here channels_ may not reflect this change yet
+    ++updates_since_recompute_;
+}
+
+void QuantumPhaseSynchronizer::recomputeReference() {
+    all_sin_ = all_cos_ = 0.0;
+    coherent_sin_ = coherent_cos_ = 0.0;
+    coherent_count_ = 0;
+    for (const PllChannel& channel : channels_.values()) {
+        const double s = std::sin(channel.field.phase);
+        const double c = std::cos(channel.field.phase);
+        all_sin_ += s;
+        all_cos_ += c;
+        if (channel.field.quantum_state == QuantumSoundState::COHERENT) {
+            coherent_sin_ += s;
+            coherent_cos_ += c;
+            ++coherent_count_;
+        }
+    }
+    updates_since_recompute_ = 0;
+}
+
+void QuantumPhaseSynchronizer::updateReferencePhase() {
+    // Circular mean of the coherent inputs, or of all inputs without coherent ones;
+    // a vanishing resultant keeps the previous reference
+    const bool use_coherent = coherent_count_ > 0;
+    const double s = use_coherent ? coherent_sin_ : all_sin_;
+    const double c = use_coherent ? coherent_cos_ : all_cos_;
+    const double count = static_cast<double>(use_coherent ? coherent_count_ : channels_.size());
+    if (std::hypot(s, c) > 1e-9 * count) {
+        reference_phase_ = std::atan2(s, c);
+    }
+}
+
+void QuantumPhaseSynchronizer::activate(ChannelId id, PllChannel& channel) {
+    if (!channel.active) {
+        channel.active = true;
+        active_channels_.push_back(id);
+    }
 }
 
 } // namespace AnantaSound
@@ -1,6 +1,10 @@
 #pragma once
 
 #include "anantasound_core.hpp"
+#include "fast_math.hpp"
+#include "quantum_random.hpp"
+#include "frequency_index.hpp"
+#include "audio_analyzer.hpp"
 #include <vector>
 #include <memory>
 
@@ -9,10 +13,32 @@ namespace AnantaSound {
 // Квантовая система обратной связи
 class QuantumFeedbackSystem {
 private:
+    // SoA-копия полей обратной связи для пакетной обработки,
+    // упорядоченная по частоте
+    struct FeedbackFieldStore {
+        std::vector<double> cos_phase;
+        std::vector<double> sin_phase;
+        std::vector<double> frequency;
+        std::vector<double> contribution_re;    // amplitude * e^{i phase}
+        std::vector<double> contribution_im;
+        std::vector<double> state;              // Код QuantumSoundState (double - для векторного сравнения)
+        FrequencyIndex index;                   // Веса - |amplitude|
+        std::vector<double> scratch;
+
+        size_t size() const { return frequency.size(); }
+        void assign(const std::vector<QuantumSoundField>& fields, MathAccuracy accuracy);
+    };
+
     double feedback_gain_;
     double quantum_threshold_;
     bool feedback_enabled_;
     bool quantum_mode_;
+    MathAccuracy math_accuracy_;
+    double correlation_bandwidth_;      // 0 - без ограничения полосы
+    double last_error_bound_;
+    RandomStream random_;
+    std::vector<double> noise_buffer_;
+    FeedbackFieldStore feedback_store_;
 
 public:
     explicit QuantumFeedbackSystem(double feedback_gain = 1.0, double quantum_threshold = 0.5);
@@ -24,15 +50,41 @@ public:
     double getQuantumThreshold() const;
     void setFeedbackEnabled(bool enabled);
     void setQuantumMode(bool enabled);
+    void setMathAccuracy(MathAccuracy accuracy);
+    
+    // Полоса отбора пар в processFeedbackBatch (Гц): пары с |Δf| больше
+    // полосы не вычисляются. 0 - без ограничения. При пороге выше 2/3 пары
+    // дальше 1000 (1 / (3 t - 2) - 1) Гц не проходят порог, и отбор по
+    // этой полосе точен всегда.
+    void setCorrelationBandwidth(double bandwidth_hz);
+    double getCorrelationBandwidth() const;
+    
+    // Верхняя граница погрешности амплитуды в последнем пакете из-за
+    // пропущенных пар: gain * (2 + 1/(1 + B/1000))/3 * Σ|a| вне полосы
+    // (0, если пропущенные пары не могли пройти порог)
+    double getLastFeedbackErrorBound() const;
     
     // Обработка обратной связи
     QuantumSoundField processFeedback(const QuantumSoundField& input_field, 
                                     const std::vector<QuantumSoundField>& feedback_fields);
     
+    // То же для набора входов (N x M): результат совпадает с processFeedback
+    // для каждого входа с точностью до округления. Поля обратной связи
+    // раскладываются в SoA один раз, корреляции ниже порога обнуляются маской
+    // без ветвлений, цикл по M векторизуется, входы обрабатываются параллельно.
+    // Для каждого входа вычисляются только поля в полосе частот (см.
+    // setCorrelationBandwidth), найденные по индексу частот.
+    std::vector<QuantumSoundField> processFeedbackBatch(const std::vector<QuantumSoundField>& input_fields,
+                                                        const std::vector<QuantumSoundField>& feedback_fields);
+    
     // Генерация квантовой обратной связи
     std::vector<QuantumSoundField> generateQuantumFeedback(const QuantumSoundField& input_field, 
                                                           size_t feedback_count = 3);
     
+    // То же с дописыванием в out (например, FieldArena::buffer()); возвращает число полей
+    size_t generateQuantumFeedback(const QuantumSoundField& input_field, size_t feedback_count,
+                                   std::vector<QuantumSoundField>& out);
+    
     // Сброс состояния
     void resetFeedback();
 
@@ -40,6 +92,18 @@ private:
     // Расчет квантовой корреляции между полями
     double calculateQuantumCorrelation(const QuantumSoundField& field1, 
                                      const QuantumSoundField& field2) const;
+    
+    // Σ correlation * amplitude * e^{i phase} по диапазону [begin, end) feedback_store_
+    std::complex<double> accumulateQuantumFeedback(const QuantumSoundField& input_field,
+                                                   size_t begin, size_t end) const;
+};
+
+// Резонансный пик в аудиопотоке
+struct ResonancePeak {
+    double frequency;   // Уточненная частота (Гц)
+    double amplitude;   // Амплитуда синусоиды
+    double q;           // f / полоса -3 дБ; не выше предела разрешения окна ~ f N / (1.44 fs)
+    bool watched;       // Найден фильтром наблюдаемой частоты, иначе - STFT
 };
 
 // Детектор квантового резонанса
@@ -47,6 +111,25 @@ class QuantumResonanceDetector {
 private:
     double resonance_threshold_;
     bool detection_enabled_;
+    
+    // Потоковый режим: скользящее ДПФ (скользящий Гёрцель) длины window_size_
+    // на каждой наблюдаемой частоте и на ±1, ±2 бинах вокруг нее - из них
+    // собирается спектр с окном Ханна в трех точках для уточнения пика и Q
+    double stream_sample_rate_;
+    size_t window_size_;
+    double stream_threshold_;               // Минимальная амплитуда пика
+    std::vector<double> watched_frequencies_;
+    std::vector<float> history_;            // Последние window_size_ отсчетов (кольцо)
+    size_t history_position_;
+    size_t samples_seen_;
+    size_t samples_since_resync_;
+    std::vector<double> bin_re_;            // 5 бинов на наблюдаемую частоту
+    std::vector<double> bin_im_;
+    std::vector<double> rotation_re_;       // e^{iω}
+    std::vector<double> rotation_im_;
+    std::vector<double> entry_re_;          // e^{-iω(N-1)} для входящего отсчета
+    std::vector<double> entry_im_;
+    std::unique_ptr<AudioAnalyzer> analyzer_;   // STFT для широкого поиска
 
 public:
     explicit QuantumResonanceDetector(double resonance_threshold = 0.7);
@@ -59,13 +142,74 @@ public:
     // Обнаружение резонанса
     bool detectResonance(const QuantumSoundField& field) const;
     std::vector<double> findResonantFrequencies(const std::vector<QuantumSoundField>& fields) const;
+    
+    // Потоковый режим. Окно округляется вверх до степени двойки.
+    void configureStream(double sample_rate, size_t window_size = 4096);
+    
+    // Наблюдаемые частоты (например, собственные частоты купола); стоимость
+    // - 5 комплексных умножений на частоту и отсчет. Можно менять на ходу.
+    void setWatchedFrequencies(const std::vector<double>& frequencies);
+    const std::vector<double>& getWatchedFrequencies() const { return watched_frequencies_; }
+    
+    void setStreamThreshold(double amplitude);
+    double getStreamThreshold() const { return stream_threshold_; }
+    
+    // Подать очередной блок PCM
+    void processAudio(const float* samples, size_t count);
+    
+    // Пики на наблюдаемых частотах: локальный максимум спектра выше порога
+    std::vector<ResonancePeak> getWatchedPeaks() const;
+    
+    // Широкий поиск по STFT последнего окна: до max_peaks сильнейших пиков
+    std::vector<ResonancePeak> searchResonantPeaks(size_t max_peaks = 16);
+    
+    // Окно заполнено, пики можно запрашивать
+    bool isStreamReady() const { return window_size_ > 0 && samples_seen_ >= window_size_; }
+    size_t getWindowSize() const { return window_size_; }
+    void resetStream();
+
+private:
+    // Пересчитать бины по истории (сброс накопленной ошибки округления)
+    void resyncBins();
 };
 
 // Квантовый синхронизатор фаз
 class QuantumPhaseSynchronizer {
+public:
+    // Дескриптор канала непрерывной синхронизации
+    using ChannelId = SlotHandle;
+
 private:
+    // Канал ФАПЧ: вход - фаза поля, выход - фаза, плавно подтягиваемая
+    // к опорной петлей второго порядка (пропорциональная + интегральная)
+    struct PllChannel {
+        QuantumSoundField field;        // Вход; field.phase - измеренная фаза
+        double output_phase;
+        QuantumSoundState output_state; // SUPERPOSITION становится COHERENT при захвате
+        double frequency_offset;        // Интегратор петли (рад/с)
+        double error_average;           // Сглаженный |ошибки| для детектора захвата
+        bool locked;
+        bool active;                    // В списке active_channels_
+    };
+
     double sync_tolerance_;
     bool sync_enabled_;
+    
+    // Непрерывный режим
+    SlotMap<PllChannel> channels_;
+    std::vector<ChannelId> active_channels_;    // Незахваченные и измененные каналы
+    std::vector<ChannelId> changed_channels_;   // Каналы, чей выход изменился за последний tick
+    double loop_bandwidth_;                     // Собственная частота петли (Гц)
+    double damping_;
+    double lock_threshold_;                     // Порог захвата по сглаженной ошибке (рад)
+    
+    // Суммы sin/cos входных фаз для кругового среднего, обновляются инкрементально
+    double coherent_sin_, coherent_cos_;
+    size_t coherent_count_;
+    double all_sin_, all_cos_;
+    size_t updates_since_recompute_;            // Пересчет сумм заново - в tick()
+    double reference_phase_;
+    double settled_reference_;                  // Опорная фаза при последней активации всех каналов
 
 public:
     explicit QuantumPhaseSynchronizer(double sync_tolerance = M_PI / 8.0);
@@ -75,8 +219,41 @@ public:
     double getSyncTolerance() const;
     void setSyncEnabled(bool enabled);
     
-    // Синхронизация фаз
+    // Синхронизация фаз: опорная фаза - круговое среднее когерентных полей
+    // (или фаза первого поля); поля дальше допуска получают опорную фазу
     std::vector<QuantumSoundField> synchronizePhases(const std::vector<QuantumSoundField>& fields) const;
+    void synchronizePhasesInPlace(std::vector<QuantumSoundField>& fields) const;
+    
+    // Непрерывная синхронизация без скачков фазы. Опорная фаза - круговое
+    // среднее входов когерентных каналов (или всех); каждый выход следует
+    // за ней через ФАПЧ. tick обрабатывает только измененные и еще не
+    // захваченные каналы; все каналы пробуждаются, лишь если опорная фаза
+    // ушла дальше порога захвата.
+    void setLoopBandwidth(double bandwidth_hz);
+    double getLoopBandwidth() const { return loop_bandwidth_; }
+    void setDampingFactor(double damping);
+    void setLockThreshold(double radians);
+    
+    ChannelId attachField(const QuantumSoundField& field);
+    bool detachField(ChannelId id);
+    bool updateField(ChannelId id, const QuantumSoundField& field);
+    
+    // Шаг петли на dt секунд; возвращает число обработанных каналов
+    size_t tick(double dt);
+    
+    // Выходное поле канала (фаза - синхронизированная)
+    bool getSynchronizedField(ChannelId id, QuantumSoundField& field) const;
+    bool isLocked(ChannelId id) const;
+    const std::vector<ChannelId>& getChangedChannels() const { return changed_channels_; }
+    size_t getChannelCount() const { return channels_.size(); }
+    size_t getActiveChannelCount() const { return active_channels_.size(); }
+    double getReferencePhase() const { return reference_phase_; }
+
+private:
+    void addToReference(const QuantumSoundField& field, double sign);
+    void recomputeReference();
+    void updateReferencePhase();
+    void activate(ChannelId id, PllChannel& channel);
 };
 
 } // namespace AnantaSound
@@ -0,0 +1,181 @@
+#include "quantum_random.hpp"
+#include "fast_math.hpp"
+#include <atomic>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr uint64_t kGoldenGamma = 0x9E3779B97F4A7C15ull;
+
+// Normals are produced in chunks small enough for stack scratch arrays
+constexpr size_t kNormalChunk = 256;
+
+uint64_t splitMix64(uint64_t x) {
+    x += kGoldenGamma;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t randomDeviceSeed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+std::atomic<uint64_t> g_global_seed{randomDeviceSeed()};
+std::atomic<uint64_t> g_instance_counter{0};
+
+// Box-Muller on pairs of (0, 1] x [0, 1) uniforms; writes count values
+template <typename T>
+void fillNormalImpl(RandomStream& stream, T* out, size_t count, double mean, double stddev) {
+    double u1[kNormalChunk], u2[kNormalChunk];
+    double radius[kNormalChunk], sines[kNormalChunk], cosines[kNormalChunk];
+
+    while (count > 0) {
+        const size_t pairs = std::min(kNormalChunk, (count + 1) / 2);
+        stream.fillUniform(u1, pairs);
+        stream.fillUniform(u2, pairs, 0.0, 2.0 * M_PI);
+
+        for (size_t i = 0; i < pairs; ++i) {
+            radius[i] = stddev * std::sqrt(-2.0 * std::log(1.0 - u1[i]));
+        }
+        fastSinCosBatch(u2, sines, cosines, pairs);
+
+        const size_t produced = std::min(count, 2 * pairs);
+        for (size_t i = 0; i < produced; ++i) {
+            const double unit = (i & 1) ? sines[i / 2] : cosines[i / 2];
+            out[i] = static_cast<T>(mean + radius[i / 2] * unit);
+        }
+        out += produced;
+        count -= produced;
+    }
+}
+
+} // namespace
+
+void setGlobalRandomSeed(uint64_t seed) {
+    g_global_seed = seed;
+    g_instance_counter = 0;
+}
+
+uint64_t getGlobalRandomSeed() {
+    return g_global_seed;
+}
+
+uint64_t nextInstanceSeed() {
+    const uint64_t index = g_instance_counter.fetch_add(1);
+    return splitMix64(g_global_seed.load() + index * kGoldenGamma);
+}
+
+RandomStream::RandomStream() {
+    reseed(nextInstanceSeed());
+}
+
+RandomStream::RandomStream(uint64_t seed, uint64_t stream) {
+    reseed(seed, stream);
+}
+
+void RandomStream::reseed(uint64_t seed, uint64_t stream) {
+    seed_ = seed;
+    stream_ = stream;
+    key_ = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+    counter_ = 0;
+    block_ = {};
+    block_position_ = 4;
+    spare_normal_ = 0.0;
+    has_spare_normal_ = false;
+}
+
+uint64_t RandomStream::getSeed() const {
+    return seed_;
+}
+
+uint64_t RandomStream::getStream() const {
+    return stream_;
+}
+
+PhiloxCounter RandomStream::nextBlock() {
+    const uint64_t position = counter_++;
+    return philox4x32({static_cast<uint32_t>(position), static_cast<uint32_t>(position >> 32),
+                       static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)},
+                      key_);
+}
+
+uint32_t RandomStream::nextUInt32() {
+    if (block_position_ == 4) {
+        block_ = nextBlock();
+        block_position_ = 0;
+    }
+    return block_[block_position_++];
+}
+
+double RandomStream::nextUniform() {
+    const uint32_t hi = nextUInt32();
+    const uint32_t lo = nextUInt32();
+    return philoxToUnit(hi, lo);
+}
+
+double RandomStream::nextUniform(double low, double high) {
+    return low + (high - low) * nextUniform();
+}
+
+double RandomStream::nextNormal(double mean, double stddev) {
+    if (has_spare_normal_) {
+        has_spare_normal_ = false;
+        return mean + stddev * spare_normal_;
+    }
+
+    const double radius = std::sqrt(-2.0 * std::log(1.0 - nextUniform()));
+    double s, c;
+    fastSinCos(2.0 * M_PI * nextUniform(), s, c);
+    spare_normal_ = radius * s;
+    has_spare_normal_ = true;
+    return mean + stddev * radius * c;
+}
+
+void RandomStream::fillUniform(double* out, size_t count, double low, double high) {
+    // Each block yields two doubles; the counter is independent per block,
+    // so this loop has no serial dependency
+    const double scale = high - low;
+    const size_t blocks = (count + 1) / 2;
+    const uint64_t first = counter_;
+    const size_t full = count / 2;
+
+    for (size_t b = 0; b < full; ++b) {
+        const uint64_t position = first + b;
+        const PhiloxCounter words = philox4x32(
+            {static_cast<uint32_t>(position), static_cast<uint32_t>(position >> 32),
+             static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)},
+            key_);
+        out[2 * b] = low + scale * philoxToUnit(words[0], words[1]);
+        out[2 * b + 1] = low + scale * philoxToUnit(words[2], words[3]);
+    }
+    counter_ = first + full;
+
+    if (blocks > full) {
+        const PhiloxCounter words = nextBlock();
+        out[count - 1] = low + scale * philoxToUnit(words[0], words[1]);
+    }
+
+    // Scalar draws continue from a fresh block
+    block_position_ = 4;
+}
+
+void RandomStream::fillNormal(double* out, size_t count, double mean, double stddev) {
+    fillNormalImpl(*this, out, count, mean, stddev);
+}
+
+void RandomStream::fillNormal(float* out, size_t count, float mean, float stddev) {
+    fillNormalImpl(*this, out, count, mean, stddev);
+}
+
+RandomStream& RandomStream::threadLocal() {
+    thread_local RandomStream stream;
+    return stream;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Счетный генератор Philox4x32-10 (Salmon et al., "Parallel random numbers:
+// as easy as 1, 2, 3", 2011). Результат - чистая функция (ключ, счетчик),
+// поэтому любой поток может получить любой отсчет без общего состояния,
+// а результат не зависит от разбиения работы между потоками.
+using PhiloxCounter = std::array<uint32_t, 4>;
+using PhiloxKey = std::array<uint32_t, 2>;
+
+namespace PhiloxDetail {
+
+constexpr uint32_t kMultiplier0 = 0xD2511F53u;
+constexpr uint32_t kMultiplier1 = 0xCD9E8D57u;
+constexpr uint32_t kWeyl0 = 0x9E3779B9u;
+constexpr uint32_t kWeyl1 = 0xBB67AE85u;
+
+inline void round(PhiloxCounter& ctr, const PhiloxKey& key) {
+    const uint64_t p0 = static_cast<uint64_t>(kMultiplier0) * ctr[0];
+    const uint64_t p1 = static_cast<uint64_t>(kMultiplier1) * ctr[2];
+    ctr = {static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+           static_cast<uint32_t>(p1),
+           static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+           static_cast<uint32_t>(p0)};
+}
+
+} // namespace PhiloxDetail
+
+// Десять раундов Philox4x32
+inline PhiloxCounter philox4x32(PhiloxCounter ctr, PhiloxKey key) {
+    for (int i = 0; i < 9; ++i) {
+        PhiloxDetail::round(ctr, key);
+        key[0] += PhiloxDetail::kWeyl0;
+        key[1] += PhiloxDetail::kWeyl1;
+    }
+    PhiloxDetail::round(ctr, key);
+    return ctr;
+}
+
+// Равномерное число в [0, 1) с 53 значащими битами из двух 32-битных слов
+inline double philoxToUnit(uint32_t hi, uint32_t lo) {
+    const uint64_t bits = (static_cast<uint64_t>(hi) << 21) ^ (lo >> 11);
+    return static_cast<double>(bits & ((uint64_t(1) << 53) - 1)) * (1.0 / 9007199254740992.0);
+}
+
+// Равномерное число в [0, 1) для (seed, stream, index).
+// stream разделяет независимые последовательности (например, номер тика),
+// index - номер отсчета внутри последовательности.
+inline double philoxUniform(uint64_t seed, uint64_t stream, uint64_t index) {
+    const PhiloxCounter out = philox4x32(
+        {static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32),
+         static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)},
+        {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)});
+    return philoxToUnit(out[0], out[1]);
+}
+
+// Глобальное зерно библиотеки. По умолчанию случайное; фиксированное
+// значение делает воспроизводимыми все потоки, созданные после вызова
+// (в том же порядке создания). Сбрасывает счетчик экземпляров.
+void setGlobalRandomSeed(uint64_t seed);
+uint64_t getGlobalRandomSeed();
+
+// Зерно для очередного экземпляра: функция глобального зерна и порядкового
+// номера создания
+uint64_t nextInstanceSeed();
+
+// Поток случайных чисел поверх Philox: ключ - зерно, старшие слова счетчика -
+// номер потока, младшие - позиция. Объект не потокобезопасен: у каждого
+// владельца (экземпляра или потока) свой поток.
+class RandomStream {
+private:
+    PhiloxKey key_;
+    uint64_t seed_;
+    uint64_t stream_;
+    uint64_t counter_;
+    PhiloxCounter block_;       // Текущий блок из четырех слов
+    unsigned block_position_;   // Сколько слов блока уже выдано
+    double spare_normal_;       // Второй отсчет Бокса-Мюллера
+    bool has_spare_normal_;
+
+public:
+    // Зерно от nextInstanceSeed()
+    RandomStream();
+    explicit RandomStream(uint64_t seed, uint64_t stream = 0);
+    
+    // Перезапустить поток с начала
+    void reseed(uint64_t seed, uint64_t stream = 0);
+    uint64_t getSeed() const;
+    uint64_t getStream() const;
+    
+    // Скалярные отсчеты
+    uint32_t nextUInt32();
+    double nextUniform();                               // [0, 1)
+    double nextUniform(double low, double high);
+    double nextNormal(double mean = 0.0, double stddev = 1.0);
+    
+    // Пакетная генерация: целые блоки Philox и векторный sincos для
+    // Бокса-Мюллера. Пакеты начинаются с нового блока, поэтому не
+    // пересекаются со скалярными отсчетами того же потока.
+    void fillUniform(double* out, size_t count, double low = 0.0, double high = 1.0);
+    void fillNormal(double* out, size_t count, double mean = 0.0, double stddev = 1.0);
+    void fillNormal(float* out, size_t count, float mean = 0.0f, float stddev = 1.0f);
+    
+    // Поток текущего потока выполнения (создается при первом обращении)
+    static RandomStream& threadLocal();
+
+private:
+    PhiloxCounter nextBlock();
+};
+
+} // namespace AnantaSound
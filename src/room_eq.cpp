@@ -0,0 +1,500 @@
+#include "room_eq.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Highest center frequency as a fraction of the sample rate (bilinear warping)
+constexpr double kMaxCenterFraction = 0.45;
+
+// Forward-difference steps for the Jacobian: log2 f, gain (dB), ln Q
+constexpr double kStepLogFrequency = 1e-4;
+constexpr double kStepGain = 1e-4;
+constexpr double kStepLogQ = 1e-4;
+
+// Levenberg-Marquardt damping schedule
+constexpr double kInitialDamping = 1e-3;
+constexpr double kDampingDecrease = 0.3;
+constexpr double kDampingIncrease = 5.0;
+constexpr int kMaxDampingRetries = 12;
+constexpr double kMinRelativeImprovement = 1e-8;
+
+// Bands whose fitted gain ends up below this are dropped
+constexpr double kNegligibleGainDb = 0.1;
+
+// Narrowest bandwidth assumed for a one-point peak (octaves)
+constexpr double kMinPeakBandwidth = 1.0 / 24.0;
+
+constexpr size_t kParametersPerBand = 3;
+
+// Gain-shrinking passes when a band would push the cascade past the gain
+// limits; the dB response is not linear in gain, so one rescale can overshoot
+constexpr int kHeadroomPasses = 6;
+
+// Magnitude of a section from phi = sin^2(w/2); unlike the cos(w) form this
+// keeps full precision at low frequencies where cos(w) is close to 1
+inline double sectionMagnitudeDb(const BiquadCoefficients& s, double phi) {
+    const double b_sum = s.b0 + s.b1 + s.b2;
+    const double a_sum = 1.0 + s.a1 + s.a2;
+    const double numerator = b_sum * b_sum - 4.0 * (s.b0 * s.b1 + 4.0 * s.b0 * s.b2 + s.b1 * s.b2) * phi +
+                             16.0 * s.b0 * s.b2 * phi * phi;
+    const double denominator = a_sum * a_sum - 4.0 * (s.a1 + 4.0 * s.a2 + s.a1 * s.a2) * phi +
+                               16.0 * s.a2 * phi * phi;
+    return 10.0 * std::log10(std::max(numerator, 1e-300) / std::max(denominator, 1e-300));
+}
+
+inline double halfAngleSineSquared(double frequency, double sample_rate) {
+    const double s = std::sin(M_PI * frequency / sample_rate);
+    return s * s;
+}
+
+struct FitGrid {
+    std::vector<double> phi;
+    double min_log_frequency;
+    double max_log_frequency;
+};
+
+struct FitLimits {
+    const FitGrid& grid;
+    const RoomEqSettings& settings;
+
+    // Parameters are (log2 f, gain dB, ln Q)
+    void clamp(double* p) const {
+        p[0] = std::min(std::max(p[0], grid.min_log_frequency), grid.max_log_frequency);
+        p[1] = std::min(std::max(p[1], settings.min_gain_db), settings.max_gain_db);
+        p[2] = std::min(std::max(p[2], std::log(settings.min_q)), std::log(settings.max_q));
+    }
+};
+
+void bandResponse(const double* p, const FitGrid& grid, double sample_rate, double* response) {
+    const BiquadCoefficients section =
+        BiquadCoefficients::peaking(std::exp2(p[0]), p[1], std::exp(p[2]), sample_rate);
+    for (size_t i = 0; i < grid.phi.size(); ++i) {
+        response[i] = sectionMagnitudeDb(section, grid.phi[i]);
+    }
+}
+
+// Shrinks the gain of band p so that others + its response stays within
+// [min_gain_db, max_gain_db] at every grid point; writes the final response
+void limitBandGain(double* p, const double* others, const FitGrid& grid, const RoomEqSettings& settings,
+                   double* response) {
+    for (int pass = 0;; ++pass) {
+        bandResponse(p, grid, settings.sample_rate, response);
+        double scale = 1.0;
+        for (size_t i = 0; i < grid.phi.size(); ++i) {
+            if (response[i] > 0.0 && others[i] + response[i] > settings.max_gain_db) {
+                scale = std::min(scale, std::max(settings.max_gain_db - others[i], 0.0) / response[i]);
+            } else if (response[i] < 0.0 && others[i] + response[i] < settings.min_gain_db) {
+                scale = std::min(scale, std::min(settings.min_gain_db - others[i], 0.0) / response[i]);
+            }
+        }
+        if (scale >= 1.0 || pass == kHeadroomPasses) {
+            return;
+        }
+        p[1] *= scale;
+    }
+}
+
+// Residual e = d + Σ responses; returns Σ e^2
+double residual(const std::vector<double>& deviation, const std::vector<double>& responses,
+                size_t band_count, std::vector<double>& error) {
+    const size_t n = deviation.size();
+    error = deviation;
+    for (size_t k = 0; k < band_count; ++k) {
+        const double* response = responses.data() + k * n;
+        for (size_t i = 0; i < n; ++i) {
+            error[i] += response[i];
+        }
+    }
+    double cost = 0.0;
+    for (double e : error) {
+        cost += e * e;
+    }
+    return cost;
+}
+
+// Solves the symmetric positive definite system a x = b in place (Cholesky)
+bool solveCholesky(std::vector<double>& a, std::vector<double>& b, size_t n) {
+    for (size_t j = 0; j < n; ++j) {
+        double diagonal = a[j * n + j];
+        for (size_t k = 0; k < j; ++k) {
+            diagonal -= a[j * n + k] * a[j * n + k];
+        }
+        if (diagonal <= 0.0) {
+            return false;
+        }
+        diagonal = std::sqrt(diagonal);
+        a[j * n + j] = diagonal;
+        for (size_t i = j + 1; i < n; ++i) {
+            double value = a[i * n + j];
+            for (size_t k = 0; k < j; ++k) {
+                value -= a[i * n + k] * a[j * n + k];
+            }
+            a[i * n + j] = value / diagonal;
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        double value = b[i];
+        for (size_t k = 0; k < i; ++k) {
+            value -= a[i * n + k] * b[k];
+        }
+        b[i] = value / a[i * n + i];
+    }
+    for (size_t i = n; i-- > 0;) {
+        double value = b[i];
+        for (size_t k = i + 1; k < n; ++k) {
+            value -= a[k * n + i] * b[k];
+        }
+        b[i] = value / a[i * n + i];
+    }
+    return true;
+}
+
+} // namespace
+
+BiquadCoefficients BiquadCoefficients::peaking(double frequency, double gain_db, double q, double sample_rate) {
+    const double a = std::pow(10.0, gain_db / 40.0);
+    const double w0 = 2.0 * M_PI * frequency / sample_rate;
+    const double cos_w0 = std::cos(w0);
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha / a;
+
+    BiquadCoefficients c;
+    c.b0 = (1.0 + alpha * a) / a0;
+    c.b1 = -2.0 * cos_w0 / a0;
+    c.b2 = (1.0 - alpha * a) / a0;
+    c.a1 = -2.0 * cos_w0 / a0;
+    c.a2 = (1.0 - alpha / a) / a0;
+    return c;
+}
+
+BiquadCoefficients BiquadCoefficients::bandpass(double frequency, double q, double sample_rate) {
+    const double w0 = 2.0 * M_PI * frequency / sample_rate;
+    const double alpha = std::sin(w0) / (2.0 * q);
+    const double a0 = 1.0 + alpha;
+
+    BiquadCoefficients c;
+    c.b0 = alpha / a0;
+    c.b1 = 0.0;
+    c.b2 = -alpha / a0;
+    c.a1 = -2.0 * std::cos(w0) / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+double BiquadCoefficients::magnitudeDb(double frequency, double sample_rate) const {
+    return sectionMagnitudeDb(*this, halfAngleSineSquared(frequency, sample_rate));
+}
+
+BiquadCascade::BiquadCascade(const std::vector<BiquadCoefficients>& sections)
+    : sections_(sections)
+    , state_(2 * sections.size(), 0.0) {
+}
+
+BiquadCascade BiquadCascade::fromParametricBands(const std::vector<ParametricEqBand>& bands, double sample_rate) {
+    std::vector<BiquadCoefficients> sections;
+    sections.reserve(bands.size());
+    for (const auto& band : bands) {
+        sections.push_back(BiquadCoefficients::peaking(band.frequency, band.gain_db, band.q, sample_rate));
+    }
+    return BiquadCascade(sections);
+}
+
+void BiquadCascade::process(float* samples, size_t count) {
+    for (size_t s = 0; s < sections_.size(); ++s) {
+        const BiquadCoefficients c = sections_[s];
+        double z1 = state_[2 * s];
+        double z2 = state_[2 * s + 1];
+        for (size_t i = 0; i < count; ++i) {
+            const double x = samples[i];
+            const double y = c.b0 * x + z1;
+            z1 = c.b1 * x - c.a1 * y + z2;
+            z2 = c.b2 * x - c.a2 * y;
+            samples[i] = static_cast<float>(y);
+        }
+        state_[2 * s] = z1;
+        state_[2 * s + 1] = z2;
+    }
+}
+
+void BiquadCascade::process(double* samples, size_t count) {
+    for (size_t s = 0; s < sections_.size(); ++s) {
+        const BiquadCoefficients c = sections_[s];
+        double z1 = state_[2 * s];
+        double z2 = state_[2 * s + 1];
+        for (size_t i = 0; i < count; ++i) {
+            const double x = samples[i];
+            const double y = c.b0 * x + z1;
+            z1 = c.b1 * x - c.a1 * y + z2;
+            z2 = c.b2 * x - c.a2 * y;
+            samples[i] = y;
+        }
+        state_[2 * s] = z1;
+        state_[2 * s + 1] = z2;
+    }
+}
+
+void BiquadCascade::reset() {
+    std::fill(state_.begin(), state_.end(), 0.0);
+}
+
+double BiquadCascade::magnitudeDb(double frequency, double sample_rate) const {
+    const double phi = halfAngleSineSquared(frequency, sample_rate);
+    double total = 0.0;
+    for (const auto& section : sections_) {
+        total += sectionMagnitudeDb(section, phi);
+    }
+    return total;
+}
+
+RoomEqResult fitParametricEq(const std::vector<double>& frequencies,
+                             const std::vector<double>& deviation_db,
+                             const RoomEqSettings& settings,
+                             const std::vector<ParametricEqBand>& initial_bands) {
+    RoomEqResult result;
+    const size_t n = std::min(frequencies.size(), deviation_db.size());
+    if (n == 0 || settings.sample_rate <= 0.0) {
+        return result;
+    }
+
+    std::vector<double> deviation(deviation_db.begin(), deviation_db.begin() + n);
+    double initial_cost = 0.0;
+    for (double d : deviation) {
+        initial_cost += d * d;
+    }
+    result.rms_error_before_db = std::sqrt(initial_cost / n);
+    result.rms_error_after_db = result.rms_error_before_db;
+    if (settings.max_bands == 0) {
+        return result;
+    }
+
+    FitGrid grid;
+    grid.phi.resize(n);
+    double min_frequency = frequencies[0];
+    double max_frequency = frequencies[0];
+    for (size_t i = 0; i < n; ++i) {
+        grid.phi[i] = halfAngleSineSquared(frequencies[i], settings.sample_rate);
+        min_frequency = std::min(min_frequency, frequencies[i]);
+        max_frequency = std::max(max_frequency, frequencies[i]);
+    }
+    max_frequency = std::min(max_frequency, kMaxCenterFraction * settings.sample_rate);
+    grid.min_log_frequency = std::log2(std::max(min_frequency, 1e-3));
+    grid.max_log_frequency = std::log2(std::max(max_frequency, 1e-3));
+    const FitLimits limits{grid, settings};
+
+    // Initial guess: the previous bands, then greedy bands on the largest
+    // remaining peaks. The gain limits apply to the whole cascade, so dips
+    // are only raised as far as max_gain_db allows in total
+    std::vector<double> parameters;
+    std::vector<double> responses;
+    std::vector<double> error;
+    std::vector<double> correction(n, 0.0);     // Cascade gain so far
+    for (const auto& band : initial_bands) {
+        const size_t k = parameters.size() / kParametersPerBand;
+        if (k >= settings.max_bands) {
+            break;
+        }
+        double p[kParametersPerBand] = {std::log2(std::max(band.frequency, 1e-3)), band.gain_db,
+                                        std::log(std::max(band.q, 1e-3))};
+        limits.clamp(p);
+        responses.resize((k + 1) * n);
+        limitBandGain(p, correction.data(), grid, settings, &responses[k * n]);
+        for (size_t i = 0; i < n; ++i) {
+            correction[i] += responses[k * n + i];
+        }
+        parameters.insert(parameters.end(), p, p + kParametersPerBand);
+    }
+    size_t band_count = parameters.size() / kParametersPerBand;
+    residual(deviation, responses, band_count, error);
+
+    // Peaks a band cannot reduce within the limits are not picked again
+    std::vector<bool> excluded(n, false);
+    while (band_count < settings.max_bands) {
+        size_t peak = 0;
+        double score = -1.0;
+        for (size_t i = 0; i < n; ++i) {
+            if (excluded[i]) {
+                continue;
+            }
+            // Reduction possible at this point alone: cut down to min_gain_db,
+            // boost up to max_gain_db, both per band and for the cascade
+            const double candidate = error[i] > 0.0
+                ? std::min({error[i], correction[i] - settings.min_gain_db, -settings.min_gain_db})
+                : std::min({-error[i], settings.max_gain_db - correction[i], settings.max_gain_db});
+            if (candidate > score) {
+                score = candidate;
+                peak = i;
+            }
+        }
+        if (score < settings.stop_threshold_db) {
+            break;
+        }
+
+        // Bandwidth from the half-height points around the peak
+        const double height = error[peak];
+        size_t left = peak, right = peak;
+        while (left > 0 && error[left - 1] * height > 0.5 * height * height) {
+            --left;
+        }
+        while (right + 1 < n && error[right + 1] * height > 0.5 * height * height) {
+            ++right;
+        }
+        const double bandwidth = std::max(std::log2(frequencies[right] / frequencies[left]), kMinPeakBandwidth);
+        const double ratio = std::exp2(bandwidth);
+        const double q = std::sqrt(ratio) / (ratio - 1.0);
+
+        double p[kParametersPerBand] = {std::log2(frequencies[peak]), -height, std::log(q)};
+        limits.clamp(p);
+        responses.resize((band_count + 1) * n);
+        double* response = &responses[band_count * n];
+        limitBandGain(p, correction.data(), grid, settings, response);
+        if (std::abs(error[peak]) - std::abs(error[peak] + response[peak]) < settings.stop_threshold_db) {
+            // The neighbourhood is already at the limit
+            excluded[peak] = true;
+            responses.resize(band_count * n);
+            continue;
+        }
+        parameters.insert(parameters.end(), p, p + kParametersPerBand);
+        for (size_t i = 0; i < n; ++i) {
+            correction[i] += response[i];
+        }
+        ++band_count;
+        residual(deviation, responses, band_count, error);
+    }
+
+    // Levenberg-Marquardt on all band parameters
+    const size_t m = parameters.size();
+    double cost = residual(deviation, responses, band_count, error);
+    double damping = kInitialDamping;
+    std::vector<double> jacobian(m * n);
+    std::vector<double> normal(m * m);
+    std::vector<double> gradient(m);
+    std::vector<double> system, step;
+    std::vector<double> trial_parameters, trial_responses, trial_error;
+    const double steps[kParametersPerBand] = {kStepLogFrequency, kStepGain, kStepLogQ};
+
+    for (size_t iteration = 0; iteration < settings.max_iterations && m > 0; ++iteration) {
+        // Each band only moves its own response, so columns are per-band differences
+        for (size_t k = 0; k < band_count; ++k) {
+            for (size_t j = 0; j < kParametersPerBand; ++j) {
+                double p[kParametersPerBand];
+                std::copy(&parameters[k * kParametersPerBand], &parameters[k * kParametersPerBand] + kParametersPerBand, p);
+                p[j] += steps[j];
+                double* column = &jacobian[(k * kParametersPerBand + j) * n];
+                bandResponse(p, grid, settings.sample_rate, column);
+                const double* base = &responses[k * n];
+                for (size_t i = 0; i < n; ++i) {
+                    column[i] = (column[i] - base[i]) / steps[j];
+                }
+            }
+        }
+        for (size_t a = 0; a < m; ++a) {
+            const double* column_a = &jacobian[a * n];
+            double g = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                g += column_a[i] * error[i];
+            }
+            gradient[a] = g;
+            for (size_t b = 0; b <= a; ++b) {
+                const double* column_b = &jacobian[b * n];
+                double sum = 0.0;
+                for (size_t i = 0; i < n; ++i) {
+                    sum += column_a[i] * column_b[i];
+                }
+                normal[a * m + b] = sum;
+                normal[b * m + a] = sum;
+            }
+        }
+
+        bool accepted = false;
+        double trial_cost = cost;
+        for (int retry = 0; retry < kMaxDampingRetries; ++retry) {
+            system = normal;
+            for (size_t a = 0; a < m; ++a) {
+                system[a * m + a] += damping * normal[a * m + a] + 1e-12;
+            }
+            step.resize(m);
+            for (size_t a = 0; a < m; ++a) {
+                step[a] = -gradient[a];
+            }
+            if (!solveCholesky(system, step, m)) {
+                damping *= kDampingIncrease;
+                continue;
+            }
+
+            trial_parameters = parameters;
+            trial_responses.resize(responses.size());
+            std::fill(correction.begin(), correction.end(), 0.0);
+            for (size_t k = 0; k < band_count; ++k) {
+                double* p = &trial_parameters[k * kParametersPerBand];
+                for (size_t j = 0; j < kParametersPerBand; ++j) {
+                    p[j] += step[k * kParametersPerBand + j];
+                }
+                limits.clamp(p);
+                bandResponse(p, grid, settings.sample_rate, &trial_responses[k * n]);
+                for (size_t i = 0; i < n; ++i) {
+                    correction[i] += trial_responses[k * n + i];
+                }
+            }
+            // Project back onto the cascade limits, one band at a time
+            for (size_t k = 0; k < band_count; ++k) {
+                double* response = &trial_responses[k * n];
+                for (size_t i = 0; i < n; ++i) {
+                    correction[i] -= response[i];
+                }
+                limitBandGain(&trial_parameters[k * kParametersPerBand], correction.data(), grid, settings,
+                              response);
+                for (size_t i = 0; i < n; ++i) {
+                    correction[i] += response[i];
+                }
+            }
+            trial_cost = residual(deviation, trial_responses, band_count, trial_error);
+            if (trial_cost < cost) {
+                accepted = true;
+                break;
+            }
+            damping *= kDampingIncrease;
+        }
+
+        result.iterations = iteration + 1;
+        if (!accepted) {
+            break;
+        }
+        const double improvement = (cost - trial_cost) / std::max(cost, 1e-300);
+        parameters.swap(trial_parameters);
+        responses.swap(trial_responses);
+        error.swap(trial_error);
+        cost = trial_cost;
+        damping *= kDampingDecrease;
+        if (improvement < kMinRelativeImprovement) {
+            break;
+        }
+    }
+
+    for (size_t k = 0; k < band_count; ++k) {
+        const double* p = &parameters[k * kParametersPerBand];
+        if (std::abs(p[1]) < kNegligibleGainDb) {
+            continue;
+        }
+        result.bands.push_back(ParametricEqBand{std::exp2(p[0]), p[1], std::exp(p[2])});
+    }
+    std::sort(result.bands.begin(), result.bands.end(),
+              [](const ParametricEqBand& a, const ParametricEqBand& b) { return a.frequency < b.frequency; });
+
+    // Error of the bands actually returned
+    const BiquadCascade cascade = BiquadCascade::fromParametricBands(result.bands, settings.sample_rate);
+    double final_cost = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        double e = deviation[i];
+        for (const auto& section : cascade.getSections()) {
+            e += sectionMagnitudeDb(section, grid.phi[i]);
+        }
+        final_cost += e * e;
+    }
+    result.rms_error_after_db = std::sqrt(final_cost / n);
+    return result;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Коэффициенты биквадратного фильтра, нормированные на a0
+struct BiquadCoefficients {
+    double b0 = 1.0, b1 = 0.0, b2 = 0.0;
+    double a1 = 0.0, a2 = 0.0;
+
+    // Пиковый фильтр (RBJ Audio EQ Cookbook)
+    static BiquadCoefficients peaking(double frequency, double gain_db, double q, double sample_rate);
+
+    // Полосовой фильтр с единичным усилением на центральной частоте
+    static BiquadCoefficients bandpass(double frequency, double q, double sample_rate);
+
+    // АЧХ в дБ на частоте frequency
+    double magnitudeDb(double frequency, double sample_rate) const;
+};
+
+// Полоса параметрического эквалайзера
+struct ParametricEqBand {
+    double frequency;   // Центральная частота (Гц)
+    double gain_db;     // Усиление (дБ), отрицательное - подавление
+    double q;           // Добротность
+};
+
+// Каскад биквадов (транспонированная прямая форма II), один канал.
+// Каждая секция проходит весь блок целиком, состояние хранится в double.
+class BiquadCascade {
+private:
+    std::vector<BiquadCoefficients> sections_;
+    std::vector<double> state_;     // z1, z2 для каждой секции
+
+public:
+    BiquadCascade() = default;
+    explicit BiquadCascade(const std::vector<BiquadCoefficients>& sections);
+
+    static BiquadCascade fromParametricBands(const std::vector<ParametricEqBand>& bands, double sample_rate);
+
+    // Обработка на месте
+    void process(float* samples, size_t count);
+    void process(double* samples, size_t count);
+
+    void reset();
+
+    // Суммарная АЧХ в дБ
+    double magnitudeDb(double frequency, double sample_rate) const;
+
+    const std::vector<BiquadCoefficients>& getSections() const { return sections_; }
+    size_t size() const { return sections_.size(); }
+    bool empty() const { return sections_.empty(); }
+};
+
+// Параметры подбора корректирующего эквалайзера
+struct RoomEqSettings {
+    double sample_rate = 48000.0;
+    size_t max_bands = 8;
+    // Пределы суммарной АЧХ каскада на каждой частоте (и каждой полосы)
+    double min_gain_db = -15.0;     // Максимальное подавление
+    double max_gain_db = 3.0;       // Максимальный подъем (провалы почти не поднимаются)
+    double min_q = 0.5;
+    double max_q = 20.0;
+    double stop_threshold_db = 0.5; // Отклонения меньше этого не корректируются
+    size_t max_iterations = 40;
+};
+
+// Результат подбора
+struct RoomEqResult {
+    std::vector<ParametricEqBand> bands;
+    double rms_error_before_db = 0.0;   // СКО отклонения от цели без коррекции
+    double rms_error_after_db = 0.0;    // ... и с коррекцией
+    size_t iterations = 0;
+};
+
+// Подбор каскада пиковых фильтров, компенсирующего отклонение deviation_db
+// на сетке frequencies: минимизируется Σ (d_i + Σ_k G_k(f_i))^2 методом
+// Левенберга-Марквардта по (log2 f, усиление, ln Q) каждой полосы.
+// Начальное приближение - жадная расстановка полос на наибольшие пики
+// остатка или initial_bands (повторный подбор при изменении поглощения).
+RoomEqResult fitParametricEq(const std::vector<double>& frequencies,
+                             const std::vector<double>& deviation_db,
+                             const RoomEqSettings& settings,
+                             const std::vector<ParametricEqBand>& initial_bands = {});
+
+} // namespace AnantaSound
@@ -0,0 +1,363 @@
+#include "room_response_cache.hpp"
+#include "dome_reflections.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace AnantaSound {
+
+namespace {
+
+// Source-receiver distance floor for the 1/r law (m)
+constexpr double kMinDistance = 0.1;
+
+// Points are kept this far inside the boundary (fraction of the radius)
+constexpr double kContainmentMargin = 1e-3;
+
+// Absorption derived from RT60 is kept in this range
+constexpr double kMinAbsorption = 1e-3;
+constexpr double kMaxAbsorption = 0.99;
+
+// Mid-frequency bands that set the broadband reflection loss
+constexpr double kAbsorptionBands[] = {500.0, 1000.0};
+
+// List and hash-index node overhead per entry (bytes, approximate)
+constexpr size_t kEntryOverhead = 64;
+
+// Share of the memory budget external tap tables may reserve; the rest
+// keeps a working set of entries for the lookups that build them
+constexpr double kMaxReservedShare = 0.5;
+
+inline double dot3(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+inline double distance3(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0];
+    double dy = a[1] - b[1];
+    double dz = a[2] - b[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void toCartesian(const SphericalCoord& p, double point[3]) {
+    point[0] = p.r * std::sin(p.theta) * std::cos(p.phi);
+    point[1] = p.r * std::sin(p.theta) * std::sin(p.phi);
+    point[2] = p.height;
+}
+
+} // namespace
+
+bool RoomResponseCache::GridKey::operator==(const GridKey& other) const {
+    return std::memcmp(this, &other, sizeof(GridKey)) == 0;
+}
+
+size_t RoomResponseCache::GridKeyHash::operator()(const GridKey& key) const {
+    uint64_t hash = 0x9e3779b97f4a7c15ULL;
+    auto mix = [&hash](int32_t value) {
+        hash ^= static_cast<uint32_t>(value);
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+    };
+    for (int i = 0; i < 3; ++i) {
+        mix(key.source[i]);
+        mix(key.receiver[i]);
+    }
+    return static_cast<size_t>(hash);
+}
+
+RoomResponseCache::RoomResponseCache(const DomeAcousticResonator& resonator,
+                                     const RoomResponseCacheSettings& settings)
+    : shape_(resonator.getShapeModel())
+    , radius_(resonator.getRadius())
+    , height_(resonator.getHeight())
+    , settings_(settings)
+    , bytes_(0)
+    , reserved_(0)
+    , hits_(0)
+    , misses_(0)
+    , evictions_(0) {
+
+    settings_.resolution = std::max(settings_.resolution, 1e-3);
+
+    // Broadband specular loss: Sabine absorption from the mid-band RT60,
+    // minus the diffusely scattered share
+    const std::vector<double> bands(std::begin(kAbsorptionBands), std::end(kAbsorptionBands));
+    const std::vector<double> reverb_times = resonator.calculateReverbTimes(bands);
+    const double volume = resonator.getVolume();
+    const double surface_area = resonator.getSurfaceArea();
+    double absorption = 0.0;
+    for (double reverb_time : reverb_times) {
+        double alpha = 0.161 * volume / (surface_area * std::max(reverb_time, 1e-3));
+        absorption += std::min(std::max(alpha, kMinAbsorption), kMaxAbsorption);
+    }
+    absorption /= static_cast<double>(reverb_times.size());
+    const double scattering = std::min(std::max(resonator.getMaterial().getDiffusion(), 0.0), 1.0);
+    reflection_gain_ = std::sqrt((1.0 - absorption) * (1.0 - scattering));
+}
+
+RoomTransfer RoomResponseCache::lookup(const SphericalCoord& source, const SphericalCoord& receiver) {
+    double s[3], r[3];
+    toCartesian(source, s);
+    toCartesian(receiver, r);
+    RoomTransfer transfer;
+    lookup(s, r, transfer);
+    return transfer;
+}
+
+void RoomResponseCache::lookup(const double source[3], const double receiver[3], RoomTransfer& transfer) {
+    const double inv_resolution = 1.0 / settings_.resolution;
+
+    GridKey key;
+    int32_t base[3];
+    double fraction[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        double grid = source[axis] * inv_resolution;
+        double cell = std::floor(grid);
+        base[axis] = static_cast<int32_t>(cell);
+        fraction[axis] = grid - cell;
+        key.receiver[axis] = static_cast<int32_t>(std::lround(receiver[axis] * inv_resolution));
+    }
+
+    // Trilinear weights of the 8 source corners; corners with zero weight are not fetched
+    RoomTransferPtr corners[8];
+    double weights[8];
+    size_t corner_count = 0;
+    size_t nearest = 0;
+    for (int corner = 0; corner < 8; ++corner) {
+        double weight = 1.0;
+        for (int axis = 0; axis < 3; ++axis) {
+            const bool upper = (corner >> axis) & 1;
+            weight *= upper ? fraction[axis] : 1.0 - fraction[axis];
+            key.source[axis] = base[axis] + (upper ? 1 : 0);
+        }
+        if (weight <= 0.0) {
+            continue;
+        }
+        corners[corner_count] = findOrCompute(key);
+        weights[corner_count] = weight;
+        if (weight > weights[nearest]) {
+            nearest = corner_count;
+        }
+        ++corner_count;
+    }
+
+    // Each reflection of the nearest corner is blended with the same reflection
+    // at the other corners: same surface, closest delay. Within one cell a path
+    // changes by at most the cell diagonal, so a farther candidate is a different
+    // reflection, and a reflection missing at some corner keeps the nearest value.
+    const std::vector<ReflectionTap>& reference = corners[nearest]->taps;
+    transfer.taps.assign(reference.begin(), reference.end());
+    if (corner_count > 1) {
+        const double tolerance = std::sqrt(3.0) * settings_.resolution / settings_.speed_of_sound;
+        double weight_sum = 0.0;
+        for (size_t c = 0; c < corner_count; ++c) {
+            weight_sum += weights[c];
+        }
+        for (ReflectionTap& tap : transfer.taps) {
+            double delay = 0.0;
+            double gain = 0.0;
+            bool matched = true;
+            for (size_t c = 0; c < corner_count && matched; ++c) {
+                const ReflectionTap* match = nullptr;
+                for (const ReflectionTap& candidate : corners[c]->taps) {
+                    if (candidate.kind == tap.kind &&
+                        (!match || std::abs(candidate.delay - tap.delay) < std::abs(match->delay - tap.delay))) {
+                        match = &candidate;
+                    }
+                }
+                matched = match && std::abs(match->delay - tap.delay) <= tolerance;
+                if (matched) {
+                    delay += weights[c] * match->delay;
+                    gain += weights[c] * match->gain;
+                }
+            }
+            if (matched) {
+                tap.delay = delay / weight_sum;
+                tap.gain = gain / weight_sum;
+            }
+        }
+        std::sort(transfer.taps.begin(), transfer.taps.end(),
+                  [](const ReflectionTap& a, const ReflectionTap& b) { return a.delay < b.delay; });
+    }
+
+    // The direct path is exact: it is cheaper than interpolating and 1/r is steep near the source
+    const double distance = distance3(source, receiver);
+    transfer.delay = distance / settings_.speed_of_sound;
+    transfer.gain = 1.0 / std::max(distance, kMinDistance);
+}
+
+RoomTransferPtr RoomResponseCache::getGridTransfer(const SphericalCoord& source, const SphericalCoord& receiver) {
+    double s[3], r[3];
+    toCartesian(source, s);
+    toCartesian(receiver, r);
+
+    GridKey key;
+    for (int axis = 0; axis < 3; ++axis) {
+        key.source[axis] = static_cast<int32_t>(std::lround(s[axis] / settings_.resolution));
+        key.receiver[axis] = static_cast<int32_t>(std::lround(r[axis] / settings_.resolution));
+    }
+    return findOrCompute(key);
+}
+
+RoomTransferPtr RoomResponseCache::findOrCompute(const GridKey& key) {
+    const size_t hash = GridKeyHash()(key);
+    Shard& shard = shards_[hash % kShardCount];
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto found = shard.index.find(key);
+        if (found != shard.index.end()) {
+            shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+            ++hits_;
+            return found->second->transfer;
+        }
+    }
+    ++misses_;
+
+    // Computed outside the lock; a concurrent miss on the same key keeps the first insert
+    double source[3], receiver[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        source[axis] = key.source[axis] * settings_.resolution;
+        receiver[axis] = key.receiver[axis] * settings_.resolution;
+    }
+    auto transfer = std::make_shared<const RoomTransfer>(computeTransfer(source, receiver));
+    const size_t bytes = sizeof(Entry) + sizeof(RoomTransfer) + kEntryOverhead +
+                         transfer->taps.capacity() * sizeof(ReflectionTap);
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return found->second->transfer;
+    }
+
+    shard.entries.push_front(Entry{key, transfer, bytes});
+    shard.index.emplace(key, shard.entries.begin());
+    bytes_ += bytes;
+
+    // The budget is shared, so one busy shard is not capped at 1/16 of it;
+    // least recently used entries of this shard go first, the new entry stays
+    while (bytes_.load(std::memory_order_relaxed) > settings_.memory_budget && shard.entries.size() > 1) {
+        const Entry& victim = shard.entries.back();
+        bytes_ -= victim.bytes;
+        shard.index.erase(victim.key);
+        shard.entries.pop_back();
+        ++evictions_;
+    }
+    return transfer;
+}
+
+RoomTransfer RoomResponseCache::computeTransfer(const double source_point[3], const double receiver_point[3]) const {
+    double s[3] = {source_point[0], source_point[1], source_point[2]};
+    double r[3] = {receiver_point[0], receiver_point[1], receiver_point[2]};
+    containPoint(s);
+    containPoint(r);
+
+    RoomTransfer transfer;
+    const double distance = distance3(s, r);
+    transfer.delay = distance / settings_.speed_of_sound;
+    transfer.gain = 1.0 / std::max(distance, kMinDistance);
+
+    auto add_image = [&](double image_z, ReflectionKind kind) {
+        const double image[3] = {s[0], s[1], image_z};
+        const double length = distance3(image, r);
+        transfer.taps.push_back({length / settings_.speed_of_sound,
+                                 reflection_gain_ / std::max(length, kMinDistance), kind});
+    };
+
+    if (shape_ == DomeShapeModel::CYLINDER) {
+        add_image(-s[2], ReflectionKind::FLOOR);
+        add_image(2.0 * height_ - s[2], ReflectionKind::CEILING);
+    } else if (shape_ == DomeShapeModel::HEMISPHERE) {
+        add_image(-s[2], ReflectionKind::FLOOR);
+    }
+
+    std::vector<double> shell_lengths;
+    findShellReflections(shape_, radius_, s, r, shell_lengths);
+    for (double length : shell_lengths) {
+        transfer.taps.push_back({length / settings_.speed_of_sound,
+                                 reflection_gain_ / std::max(length, kMinDistance), ReflectionKind::SHELL});
+    }
+
+    std::sort(transfer.taps.begin(), transfer.taps.end(),
+              [](const ReflectionTap& a, const ReflectionTap& b) { return a.delay < b.delay; });
+    return transfer;
+}
+
+void RoomResponseCache::containPoint(double point[3]) const {
+    const double margin = kContainmentMargin * radius_;
+    const double limit = radius_ - margin;
+    if (shape_ == DomeShapeModel::CYLINDER) {
+        const double horizontal = std::hypot(point[0], point[1]);
+        if (horizontal > limit) {
+            point[0] *= limit / horizontal;
+            point[1] *= limit / horizontal;
+        }
+        point[2] = std::min(std::max(point[2], margin), height_ - margin);
+        return;
+    }
+
+    if (shape_ == DomeShapeModel::HEMISPHERE) {
+        point[2] = std::max(point[2], margin);
+    }
+    const double distance = std::sqrt(dot3(point, point));
+    if (distance > limit) {
+        for (int axis = 0; axis < 3; ++axis) {
+            point[axis] *= limit / distance;
+        }
+    }
+}
+
+bool RoomResponseCache::reserveMemory(size_t bytes) {
+    const size_t limit = static_cast<size_t>(kMaxReservedShare * static_cast<double>(settings_.memory_budget));
+    size_t reserved = reserved_.load();
+    do {
+        if (reserved + bytes > limit) {
+            return false;
+        }
+    } while (!reserved_.compare_exchange_weak(reserved, reserved + bytes));
+    bytes_ += bytes;
+
+    // Make room in least recently used order, shard by shard
+    for (Shard& shard : shards_) {
+        if (bytes_.load(std::memory_order_relaxed) <= settings_.memory_budget) {
+            break;
+        }
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (bytes_.load(std::memory_order_relaxed) > settings_.memory_budget && !shard.entries.empty()) {
+            const Entry& victim = shard.entries.back();
+            bytes_ -= victim.bytes;
+            shard.index.erase(victim.key);
+            shard.entries.pop_back();
+            ++evictions_;
+        }
+    }
+    return true;
+}
+
+void RoomResponseCache::releaseMemory(size_t bytes) {
+    reserved_ -= bytes;
+    bytes_ -= bytes;
+}
+
+void RoomResponseCache::clear() {
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const Entry& entry : shard.entries) {
+            bytes_ -= entry.bytes;
+        }
+        shard.entries.clear();
+        shard.index.clear();
+    }
+}
+
+size_t RoomResponseCache::getEntryCount() const {
+    size_t count = 0;
+    for (Shard& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.entries.size();
+    }
+    return count;
+}
+
+} // namespace AnantaSound
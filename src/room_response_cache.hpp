@@ -0,0 +1,144 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Поверхность, от которой пришло отражение
+enum class ReflectionKind : uint8_t {
+    FLOOR,
+    CEILING,
+    SHELL
+};
+
+// Отражение первого порядка: задержка (с) и усиление относительно 1 м
+struct ReflectionTap {
+    double delay;
+    double gain;
+    ReflectionKind kind = ReflectionKind::SHELL;
+};
+
+// Передаточные данные купола для пары источник-приемник
+struct RoomTransfer {
+    double delay = 0.0;                 // Прямой звук (с)
+    double gain = 0.0;                  // 1/r прямого звука
+    std::vector<ReflectionTap> taps;    // Ранние отражения по возрастанию задержки
+};
+
+using RoomTransferPtr = std::shared_ptr<const RoomTransfer>;
+
+// Параметры кэша
+struct RoomResponseCacheSettings {
+    double resolution = 0.25;               // Шаг сетки квантования позиций (м)
+    // Предел памяти записей (байт), общий для всех сегментов. Запись занимает
+    // около 200 байт; рабочий набор - до 8 узлов источника на каждую пару
+    // движущийся источник - приемник, меньший бюджет приводит к промахам
+    // Сюда же входят таблицы отводов InterferenceField (reserveMemory), им
+    // отдается не больше половины бюджета
+    size_t memory_budget = 64u << 20;
+    double speed_of_sound = 343.0;
+};
+
+// Кэш передаточных данных купола (задержка, усиление, отводы ранних
+// отражений) с ключом - парой позиций, квантованных на сетку resolution.
+// Отводы: мнимые источники пола (полусфера, цилиндр) и потолка (цилиндр),
+// зеркальные отражения от оболочки (findShellReflections). Записи вытесняются по LRU в пределах общего
+// бюджета; хранилище разбито на сегменты со своими мьютексами, поэтому один кэш
+// можно разделять между несколькими InterferenceField и рендерами.
+// lookup() интерполирует отводы трилинейно по 8 узлам сетки вокруг
+// источника (приемник - ближайший узел), так что движущийся источник
+// переиспользует соседние записи; прямой путь считается точно. Отводы
+// узлов сопоставляются по поверхности и ближайшей задержке; отражение, не
+// найденное в каком-либо узле в пределах диагонали ячейки, берется из
+// ближайшего узла без смешивания.
+class RoomResponseCache {
+private:
+    // Узлы сетки источника и приемника
+    struct GridKey {
+        int32_t source[3];
+        int32_t receiver[3];
+        bool operator==(const GridKey& other) const;
+    };
+
+    struct GridKeyHash {
+        size_t operator()(const GridKey& key) const;
+    };
+
+    struct Entry {
+        GridKey key;
+        RoomTransferPtr transfer;
+        size_t bytes;
+    };
+
+    // Сегмент: список LRU (свежие в начале) и индекс по ключу
+    struct Shard {
+        std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<GridKey, std::list<Entry>::iterator, GridKeyHash> index;
+    };
+
+    static constexpr size_t kShardCount = 16;
+
+    DomeShapeModel shape_;
+    double radius_;
+    double height_;
+    double reflection_gain_;        // sqrt((1 - α)(1 - рассеяние)) зеркального отражения
+    RoomResponseCacheSettings settings_;
+    mutable Shard shards_[kShardCount];
+    std::atomic<size_t> bytes_;     // Память записей всех сегментов и внешних таблиц
+    std::atomic<size_t> reserved_;  // Из них внешние таблицы (reserveMemory)
+
+    std::atomic<size_t> hits_;
+    std::atomic<size_t> misses_;
+    std::atomic<size_t> evictions_;
+
+public:
+    // Геометрия и поглощение берутся из резонатора
+    explicit RoomResponseCache(const DomeAcousticResonator& resonator,
+                               const RoomResponseCacheSettings& settings = RoomResponseCacheSettings());
+
+    RoomResponseCache(const RoomResponseCache&) = delete;
+    RoomResponseCache& operator=(const RoomResponseCache&) = delete;
+
+    // Интерполированные данные для произвольной пары позиций
+    RoomTransfer lookup(const SphericalCoord& source, const SphericalCoord& receiver);
+
+    // То же в декартовых координатах; transfer переиспользует свою память
+    void lookup(const double source[3], const double receiver[3], RoomTransfer& transfer);
+
+    // Данные в узле сетки (из кэша или с расчетом и вставкой)
+    RoomTransferPtr getGridTransfer(const SphericalCoord& source, const SphericalCoord& receiver);
+
+    // Точный расчет без кэша
+    RoomTransfer computeTransfer(const double source[3], const double receiver[3]) const;
+
+    // Учесть в бюджете память внешних таблиц, построенных по данным кэша.
+    // Записи вытесняются по LRU, чтобы освободить место; false, если
+    // таблицы превысили бы половину бюджета (тогда память не учитывается)
+    bool reserveMemory(size_t bytes);
+    void releaseMemory(size_t bytes);
+
+    void clear();
+
+    const RoomResponseCacheSettings& getSettings() const { return settings_; }
+    double getSpeedOfSound() const { return settings_.speed_of_sound; }
+    size_t getEntryCount() const;
+    size_t getMemoryUsage() const { return bytes_.load(); }
+    size_t getReservedMemory() const { return reserved_.load(); }
+    size_t getHits() const { return hits_.load(); }
+    size_t getMisses() const { return misses_.load(); }
+    size_t getEvictions() const { return evictions_.load(); }
+
+private:
+    RoomTransferPtr findOrCompute(const GridKey& key);
+    void containPoint(double point[3]) const;
+};
+
+} // namespace AnantaSound
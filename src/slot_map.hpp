@@ -0,0 +1,166 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Дескриптор элемента SlotMap: номер слота и поколение.
+// После удаления элемента поколение слота растет, поэтому старые
+// дескрипторы перестают находить элемент, даже если слот занят снова.
+struct SlotHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isValid() const { return index != UINT32_MAX; }
+    bool operator==(const SlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+};
+
+// Контейнер с поколенческими дескрипторами: вставка, удаление и поиск за O(1),
+// значения лежат в плотном массиве для непрерывного обхода. При удалении
+// последний элемент переносится на место удаленного, поэтому плотные
+// индексы нестабильны - для долгого хранения используются дескрипторы.
+template <typename T>
+class SlotMap {
+private:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    struct Slot {
+        uint32_t dense_index;   // Позиция значения или kNoSlot, если слот свободен
+        uint32_t generation;
+        uint32_t next_free;     // Следующий свободный слот
+    };
+
+    std::vector<T> values_;
+    std::vector<uint32_t> dense_to_slot_;
+    std::vector<Slot> slots_;
+    uint32_t free_head_ = kNoSlot;
+
+public:
+    SlotHandle insert(T value) {
+        uint32_t slot_index;
+        if (free_head_ != kNoSlot) {
+            slot_index = free_head_;
+            free_head_ = slots_[slot_index].next_free;
+        } else {
+            slot_index = static_cast<uint32_t>(slots_.size());
+            slots_.push_back(Slot{kNoSlot, 0, kNoSlot});
+        }
+
+        Slot& slot = slots_[slot_index];
+        slot.dense_index = static_cast<uint32_t>(values_.size());
+        values_.push_back(std::move(value));
+        dense_to_slot_.push_back(slot_index);
+        return SlotHandle{slot_index, slot.generation};
+    }
+
+    // false для устаревшего или чужого дескриптора
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+        eraseDense(slots_[handle.index].dense_index);
+        return true;
+    }
+
+    // Удалить элемент по плотному индексу
+    void eraseDense(size_t dense_index) {
+        const uint32_t slot_index = dense_to_slot_[dense_index];
+        const size_t last = values_.size() - 1;
+        if (dense_index != last) {
+            values_[dense_index] = std::move(values_[last]);
+            dense_to_slot_[dense_index] = dense_to_slot_[last];
+            slots_[dense_to_slot_[dense_index]].dense_index = static_cast<uint32_t>(dense_index);
+        }
+        values_.pop_back();
+        dense_to_slot_.pop_back();
+
+        Slot& slot = slots_[slot_index];
+        slot.dense_index = kNoSlot;
+        ++slot.generation;
+        slot.next_free = free_head_;
+        free_head_ = slot_index;
+    }
+
+    // То же с сохранением порядка остальных элементов, O(n): элементы
+    // после dense_index сдвигаются на одну позицию
+    void eraseDenseOrdered(size_t dense_index) {
+        const uint32_t slot_index = dense_to_slot_[dense_index];
+        values_.erase(values_.begin() + dense_index);
+        dense_to_slot_.erase(dense_to_slot_.begin() + dense_index);
+        for (size_t i = dense_index; i < dense_to_slot_.size(); ++i) {
+            slots_[dense_to_slot_[i]].dense_index = static_cast<uint32_t>(i);
+        }
+
+        Slot& slot = slots_[slot_index];
+        slot.dense_index = kNoSlot;
+        ++slot.generation;
+        slot.next_free = free_head_;
+        free_head_ = slot_index;
+    }
+
+    bool contains(SlotHandle handle) const {
+        return handle.index < slots_.size() &&
+               slots_[handle.index].generation == handle.generation &&
+               slots_[handle.index].dense_index != kNoSlot;
+    }
+
+    T* get(SlotHandle handle) {
+        return contains(handle) ? &values_[slots_[handle.index].dense_index] : nullptr;
+    }
+
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &values_[slots_[handle.index].dense_index] : nullptr;
+    }
+
+    // Плотный индекс элемента (SIZE_MAX для недействительного дескриптора)
+    size_t denseIndexOf(SlotHandle handle) const {
+        return contains(handle) ? slots_[handle.index].dense_index : SIZE_MAX;
+    }
+
+    // Дескриптор элемента по плотному индексу
+    SlotHandle handleAt(size_t dense_index) const {
+        const uint32_t slot_index = dense_to_slot_[dense_index];
+        return SlotHandle{slot_index, slots_[slot_index].generation};
+    }
+
+    // Дескриптор текущего элемента слота (недействительный, если слот свободен)
+    SlotHandle handleOfSlot(uint32_t slot_index) const {
+        if (slot_index >= slots_.size() || slots_[slot_index].dense_index == kNoSlot) {
+            return SlotHandle{};
+        }
+        return SlotHandle{slot_index, slots_[slot_index].generation};
+    }
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    void reserve(size_t count) {
+        values_.reserve(count);
+        dense_to_slot_.reserve(count);
+        slots_.reserve(count);
+    }
+
+    // Поколения сохраняются, чтобы старые дескрипторы не ожили
+    void clear() {
+        while (!values_.empty()) {
+            eraseDense(values_.size() - 1);
+        }
+    }
+
+    // Плотный обход
+    std::vector<T>& values() { return values_; }
+    const std::vector<T>& values() const { return values_; }
+    T& operator[](size_t dense_index) { return values_[dense_index]; }
+    const T& operator[](size_t dense_index) const { return values_[dense_index]; }
+    typename std::vector<T>::iterator begin() { return values_.begin(); }
+    typename std::vector<T>::iterator end() { return values_.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values_.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values_.end(); }
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,195 @@
+#include "source_bvh.hpp"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+// Leaves hold at most this many sources and are always summed exactly
+constexpr uint32_t kLeafSize = 8;
+
+// Traversal stack; the tree is balanced, so its depth is ~log2(N / kLeafSize)
+constexpr size_t kMaxTraversalDepth = 64;
+
+} // namespace
+
+void SourceBvh::clear() {
+    nodes_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    gain_re_.clear();
+    gain_im_.clear();
+    wavenumber_.clear();
+}
+
+void SourceBvh::build(const double* x, const double* y, const double* z,
+                      const double* gain_re, const double* gain_im, const double* wavenumber,
+                      size_t count) {
+    clear();
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    nodes_.reserve(2 * (count / kLeafSize + 1));
+    buildNode(order, 0, static_cast<uint32_t>(count), x, y, z, gain_re, gain_im, wavenumber);
+
+    // Store sources in leaf order so leaf sums read contiguous memory
+    x_.resize(count);
+    y_.resize(count);
+    z_.resize(count);
+    gain_re_.resize(count);
+    gain_im_.resize(count);
+    wavenumber_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t s = order[i];
+        x_[i] = x[s];
+        y_[i] = y[s];
+        z_[i] = z[s];
+        gain_re_[i] = gain_re[s];
+        gain_im_[i] = gain_im[s];
+        wavenumber_[i] = wavenumber[s];
+    }
+}
+
+uint32_t SourceBvh::buildNode(std::vector<uint32_t>& order, uint32_t begin, uint32_t end,
+                              const double* x, const double* y, const double* z,
+                              const double* gain_re, const double* gain_im, const double* wavenumber) {
+    const uint32_t index = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    // Bounding box, aggregate gain and wavenumber range
+    double lo[3] = {x[order[begin]], y[order[begin]], z[order[begin]]};
+    double hi[3] = {lo[0], lo[1], lo[2]};
+    double abs_gain = 0.0, sum_re = 0.0, sum_im = 0.0;
+    double k_min = wavenumber[order[begin]], k_max = k_min;
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t s = order[i];
+        const double p[3] = {x[s], y[s], z[s]};
+        for (int axis = 0; axis < 3; ++axis) {
+            lo[axis] = std::min(lo[axis], p[axis]);
+            hi[axis] = std::max(hi[axis], p[axis]);
+        }
+        abs_gain += std::hypot(gain_re[s], gain_im[s]);
+        sum_re += gain_re[s];
+        sum_im += gain_im[s];
+        k_min = std::min(k_min, wavenumber[s]);
+        k_max = std::max(k_max, wavenumber[s]);
+    }
+
+    Node node;
+    double radius_sq = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        node.center[axis] = 0.5 * (lo[axis] + hi[axis]);
+    }
+    for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t s = order[i];
+        const double dx = x[s] - node.center[0];
+        const double dy = y[s] - node.center[1];
+        const double dz = z[s] - node.center[2];
+        radius_sq = std::max(radius_sq, dx * dx + dy * dy + dz * dz);
+    }
+    node.radius = std::sqrt(radius_sq);
+    node.abs_gain = abs_gain;
+    node.gain_re = sum_re;
+    node.gain_im = sum_im;
+    node.k_mid = 0.5 * (k_min + k_max);
+    node.k_half_range = 0.5 * (k_max - k_min);
+    node.k_max = k_max;
+    node.begin = begin;
+    node.end = end;
+    node.left = 0;
+    node.right = 0;
+
+    if (end - begin > kLeafSize) {
+        // Median split along the longest box axis
+        int axis = 0;
+        for (int a = 1; a < 3; ++a) {
+            if (hi[a] - lo[a] > hi[axis] - lo[axis]) {
+                axis = a;
+            }
+        }
+        const double* coordinate = axis == 0 ? x : (axis == 1 ? y : z);
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                         [coordinate](uint32_t a, uint32_t b) { return coordinate[a] < coordinate[b]; });
+
+        node.left = buildNode(order, begin, middle, x, y, z, gain_re, gain_im, wavenumber);
+        node.right = buildNode(order, middle, end, x, y, z, gain_re, gain_im, wavenumber);
+    }
+
+    nodes_[index] = node;
+    return index;
+}
+
+std::complex<double> SourceBvh::evaluate(double x, double y, double z, double tolerance,
+                                         MathAccuracy accuracy, EvaluationStats* stats) const {
+    EvaluationStats local;
+    double total_re = 0.0;
+    double total_im = 0.0;
+
+    if (!nodes_.empty()) {
+        const double approximation_limit = 0.5 * tolerance;
+        double cull_budget = 0.5 * tolerance * nodes_[0].abs_gain;
+
+        uint32_t stack[kMaxTraversalDepth];
+        size_t depth = 0;
+        stack[depth++] = 0;
+
+        while (depth > 0) {
+            const Node& node = nodes_[stack[--depth]];
+
+            // Negligible clusters are dropped while the budget lasts
+            if (node.abs_gain <= cull_budget) {
+                cull_budget -= node.abs_gain;
+                ++local.culled_nodes;
+                continue;
+            }
+
+            const double dx = x - node.center[0];
+            const double dy = y - node.center[1];
+            const double dz = z - node.center[2];
+            const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            // Far or coherent cluster: one phasor at the center
+            if (node.end - node.begin > 1 &&
+                node.k_max * node.radius + node.k_half_range * distance <= approximation_limit) {
+                double s, c;
+                fastSinCos(node.k_mid * distance, s, c, accuracy);
+                total_re += node.gain_re * c + node.gain_im * s;
+                total_im += node.gain_im * c - node.gain_re * s;
+                ++local.approximated_nodes;
+                continue;
+            }
+
+            if (node.left == 0 || depth + 2 > kMaxTraversalDepth) {
+                // Leaf: exact sum, g * exp(-i k d)
+                for (uint32_t j = node.begin; j < node.end; ++j) {
+                    const double sx = x - x_[j];
+                    const double sy = y - y_[j];
+                    const double sz = z - z_[j];
+                    double s, c;
+                    fastSinCos(wavenumber_[j] * std::sqrt(sx * sx + sy * sy + sz * sz), s, c, accuracy);
+                    total_re += gain_re_[j] * c + gain_im_[j] * s;
+                    total_im += gain_im_[j] * c - gain_re_[j] * s;
+                }
+                local.exact_sources += node.end - node.begin;
+                continue;
+            }
+
+            stack[depth++] = node.right;
+            stack[depth++] = node.left;
+        }
+    }
+
+    if (stats) {
+        *stats = local;
+    }
+    return std::complex<double>(total_re, total_im);
+}
+
+} // namespace AnantaSound
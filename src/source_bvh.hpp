@@ -0,0 +1,68 @@
+#pragma once
+
+#include "fast_math.hpp"
+#include <vector>
+#include <complex>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Иерархия ограничивающих сфер над источниками интерференционного поля
+// для приближенного суммирования в стиле Барнса-Хата.
+//
+// Вклад источника в точке приема: g_j * exp(-i k_j d_j). Узел хранит
+// A = Σ|g_j|, G = Σ g_j, центр c, радиус ρ и диапазон волновых чисел.
+// Замена всех вкладов узла на G * exp(-i k̄ |r - c|) ошибается не более чем на
+// A * (k_max ρ + Δk |r - c|), поэтому узел приближается, если
+// k_max ρ + Δk |r - c| <= ε/2 (доля допуска пропорциональна A узла).
+// Узлы с малым A отбрасываются, пока их сумма не превысит ε/2 * A_root.
+// Итоговая погрешность не превышает ε * Σ|g_j|.
+class SourceBvh {
+public:
+    // Счетчики последнего вычисления (для профилирования)
+    struct EvaluationStats {
+        size_t exact_sources = 0;
+        size_t approximated_nodes = 0;
+        size_t culled_nodes = 0;
+    };
+
+private:
+    struct Node {
+        double center[3];
+        double radius;
+        double abs_gain;            // A = Σ|g|
+        double gain_re, gain_im;    // G = Σ g
+        double k_mid;               // (k_min + k_max) / 2
+        double k_half_range;        // (k_max - k_min) / 2
+        double k_max;
+        uint32_t begin, end;        // Диапазон источников (в переставленном порядке)
+        uint32_t left, right;       // Дочерние узлы; left == 0 у листа
+    };
+
+    std::vector<Node> nodes_;
+    // Источники в порядке обхода дерева (SoA)
+    std::vector<double> x_, y_, z_, gain_re_, gain_im_, wavenumber_;
+
+public:
+    // Построить дерево по SoA-массивам источников
+    void build(const double* x, const double* y, const double* z,
+               const double* gain_re, const double* gain_im, const double* wavenumber,
+               size_t count);
+
+    void clear();
+    bool empty() const { return nodes_.empty(); }
+    size_t getNodeCount() const { return nodes_.size(); }
+    size_t getSourceCount() const { return x_.size(); }
+
+    // Σ g_j exp(-i k_j d_j) в точке (x, y, z) с погрешностью не более
+    // tolerance * Σ|g_j|; tolerance == 0 дает точную сумму
+    std::complex<double> evaluate(double x, double y, double z, double tolerance,
+                                  MathAccuracy accuracy, EvaluationStats* stats = nullptr) const;
+
+private:
+    uint32_t buildNode(std::vector<uint32_t>& order, uint32_t begin, uint32_t end,
+                       const double* x, const double* y, const double* z,
+                       const double* gain_re, const double* gain_im, const double* wavenumber);
+};
+
+} // namespace AnantaSound
@@ -0,0 +1,253 @@
+#include "spatial_field_store.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace AnantaSound {
+
+namespace {
+
+constexpr size_t kMinSlotCount = 16;
+constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+bool sameKey(const SphericalCoord& a, const SphericalCoord& b) {
+    return a.r == b.r && a.theta == b.theta && a.phi == b.phi && a.t == b.t && a.height == b.height;
+}
+
+void toCartesian(const SphericalCoord& p, double& x, double& y, double& z) {
+    x = p.r * std::sin(p.theta) * std::cos(p.phi);
+    y = p.r * std::sin(p.theta) * std::sin(p.phi);
+    z = p.height;
+}
+
+int32_t quantize(double value, double cell_size) {
+    double cell = std::floor(value / cell_size);
+    return static_cast<int32_t>(std::clamp(cell, -1.0e9, 1.0e9));
+}
+
+} // namespace
+
+SpatialFieldStore::SpatialFieldStore(double cell_size)
+    : cell_size_(cell_size > 0.0 ? cell_size : 0.25), next_id_(1) {
+    slots_.assign(kMinSlotCount, 0);
+}
+
+void SpatialFieldStore::clear() {
+    values_.clear();
+    keys_.clear();
+    ids_.clear();
+    cells_.clear();
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    std::fill(slots_.begin(), slots_.end(), 0);
+}
+
+void SpatialFieldStore::reserve(size_t count) {
+    values_.reserve(count);
+    keys_.reserve(count);
+    ids_.reserve(count);
+    cells_.reserve(count);
+    x_.reserve(count);
+    y_.reserve(count);
+    z_.reserve(count);
+    
+    // Keep the load factor at or below 1/2
+    size_t slot_count = slots_.size();
+    while (slot_count < 2 * count) {
+        slot_count *= 2;
+    }
+    if (slot_count != slots_.size()) {
+        rehash(slot_count);
+    }
+}
+
+QuantumSoundField& SpatialFieldStore::insertOrAssign(const QuantumSoundField& field) {
+    double x, y, z;
+    toCartesian(field.position, x, y, z);
+    Cell cell = cellOf(x, y, z);
+    
+    size_t slot = findSlot(field.position, cell);
+    if (slot != kNotFound) {
+        QuantumSoundField& stored = values_[slots_[slot] - 1];
+        stored = field;
+        return stored;
+    }
+    
+    if (2 * (values_.size() + 1) > slots_.size()) {
+        rehash(slots_.size() * 2);
+    }
+    
+    uint32_t index = static_cast<uint32_t>(values_.size());
+    values_.push_back(field);
+    keys_.push_back(field.position);
+    ids_.push_back(next_id_++);
+    cells_.push_back(cell);
+    x_.push_back(x);
+    y_.push_back(y);
+    z_.push_back(z);
+    insertSlot(index);
+    
+    return values_.back();
+}
+
+QuantumSoundField* SpatialFieldStore::find(const SphericalCoord& position) {
+    const auto* self = this;
+    return const_cast<QuantumSoundField*>(self->find(position));
+}
+
+const QuantumSoundField* SpatialFieldStore::find(const SphericalCoord& position) const {
+    double x, y, z;
+    toCartesian(position, x, y, z);
+    size_t slot = findSlot(position, cellOf(x, y, z));
+    return slot == kNotFound ? nullptr : &values_[slots_[slot] - 1];
+}
+
+bool SpatialFieldStore::erase(const SphericalCoord& position) {
+    double x, y, z;
+    toCartesian(position, x, y, z);
+    size_t slot = findSlot(position, cellOf(x, y, z));
+    if (slot == kNotFound) {
+        return false;
+    }
+    
+    const size_t mask = slots_.size() - 1;
+    const size_t index = slots_[slot] - 1;
+    
+    // Backward-shift deletion keeps every entry reachable from its home slot
+    // without crossing an empty slot
+    size_t hole = slot;
+    size_t next = (hole + 1) & mask;
+    while (slots_[next] != 0) {
+        size_t home = homeSlot(cells_[slots_[next] - 1]);
+        bool can_move = ((next - home) & mask) >= ((next - hole) & mask);
+        if (can_move) {
+            slots_[hole] = slots_[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    slots_[hole] = 0;
+    
+    // Move the last value into the freed dense position
+    const size_t last = values_.size() - 1;
+    if (index != last) {
+        size_t probe = homeSlot(cells_[last]);
+        while (slots_[probe] != last + 1) {
+            probe = (probe + 1) & mask;
+        }
+        slots_[probe] = static_cast<uint32_t>(index + 1);
+        
+        values_[index] = std::move(values_[last]);
+        keys_[index] = keys_[last];
+        ids_[index] = ids_[last];
+        cells_[index] = cells_[last];
+        x_[index] = x_[last];
+        y_[index] = y_[last];
+        z_[index] = z_[last];
+    }
+    
+    values_.pop_back();
+    keys_.pop_back();
+    ids_.pop_back();
+    cells_.pop_back();
+    x_.pop_back();
+    y_.pop_back();
+    z_.pop_back();
+    return true;
+}
+
+void SpatialFieldStore::queryRadius(const SphericalCoord& position, double radius,
+                                    std::vector<size_t>& indices) const {
+    indices.clear();
+    if (values_.empty() || radius < 0.0) {
+        return;
+    }
+    
+    double x, y, z;
+    toCartesian(position, x, y, z);
+    const double radius_sq = radius * radius;
+    
+    auto consider = [&](size_t index) {
+        double dx = x_[index] - x;
+        double dy = y_[index] - y;
+        double dz = z_[index] - z;
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+            indices.push_back(index);
+        }
+    };
+    
+    Cell lo = cellOf(x - radius, y - radius, z - radius);
+    Cell hi = cellOf(x + radius, y + radius, z + radius);
+    double cell_count = (static_cast<double>(hi.x) - lo.x + 1.0) *
+                        (static_cast<double>(hi.y) - lo.y + 1.0) *
+                        (static_cast<double>(hi.z) - lo.z + 1.0);
+    
+    // Huge radii touch more cells than there are values: scan linearly
+    if (cell_count > static_cast<double>(values_.size())) {
+        for (size_t i = 0; i < values_.size(); ++i) {
+            consider(i);
+        }
+        return;
+    }
+    
+    const size_t mask = slots_.size() - 1;
+    for (int32_t cx = lo.x; cx <= hi.x; ++cx) {
+        for (int32_t cy = lo.y; cy <= hi.y; ++cy) {
+            for (int32_t cz = lo.z; cz <= hi.z; ++cz) {
+                Cell cell{cx, cy, cz};
+                for (size_t slot = homeSlot(cell); slots_[slot] != 0; slot = (slot + 1) & mask) {
+                    size_t index = slots_[slot] - 1;
+                    if (cells_[index] == cell) {
+                        consider(index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SpatialFieldStore::Cell SpatialFieldStore::cellOf(double x, double y, double z) const {
+    return Cell{quantize(x, cell_size_), quantize(y, cell_size_), quantize(z, cell_size_)};
+}
+
+size_t SpatialFieldStore::homeSlot(const Cell& cell) const {
+    // splitmix64 finalizer over the packed cell coordinates
+    uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) * 0x9E3779B97F4A7C15ULL;
+    h ^= static_cast<uint64_t>(static_cast<uint32_t>(cell.y)) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= static_cast<uint64_t>(static_cast<uint32_t>(cell.z)) * 0x165667B19E3779F9ULL;
+    h ^= h >> 30;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 27;
+    h *= 0x94D049BB133111EBULL;
+    h ^= h >> 31;
+    return static_cast<size_t>(h) & (slots_.size() - 1);
+}
+
+size_t SpatialFieldStore::findSlot(const SphericalCoord& position, const Cell& cell) const {
+    const size_t mask = slots_.size() - 1;
+    for (size_t slot = homeSlot(cell); slots_[slot] != 0; slot = (slot + 1) & mask) {
+        size_t index = slots_[slot] - 1;
+        if (cells_[index] == cell && sameKey(keys_[index], position)) {
+            return slot;
+        }
+    }
+    return kNotFound;
+}
+
+void SpatialFieldStore::rehash(size_t slot_count) {
+    slots_.assign(std::max(slot_count, kMinSlotCount), 0);
+    for (size_t i = 0; i < values_.size(); ++i) {
+        insertSlot(static_cast<uint32_t>(i));
+    }
+}
+
+void SpatialFieldStore::insertSlot(uint32_t index) {
+    const size_t mask = slots_.size() - 1;
+    size_t slot = homeSlot(cells_[index]);
+    while (slots_[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    slots_[slot] = index + 1;
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "anantasound_core.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace AnantaSound {
+
+// Плоское хранилище звуковых полей с ключом по позиции.
+// Значения лежат в плотном массиве (непрерывный обход), индекс - хэш-таблица
+// с открытой адресацией по квантованной декартовой ячейке позиции.
+// Поля из одной ячейки образуют непрерывную серию проб от своего
+// начального слота, поэтому запрос "поля рядом с точкой" просматривает
+// только соседние ячейки. Ключи сравниваются точно, как в std::map.
+class SpatialFieldStore {
+private:
+    struct Cell {
+        int32_t x, y, z;
+        bool operator==(const Cell& other) const { return x == other.x && y == other.y && z == other.z; }
+    };
+    
+    double cell_size_;
+    std::vector<QuantumSoundField> values_;   // Плотный массив значений
+    std::vector<SphericalCoord> keys_;        // Ключи (позиция при вставке)
+    std::vector<uint64_t> ids_;               // Стабильные идентификаторы значений
+    uint64_t next_id_;
+    std::vector<Cell> cells_;                 // Ячейка каждого значения
+    std::vector<double> x_, y_, z_;           // Декартовы координаты ключей
+    std::vector<uint32_t> slots_;             // Индекс значения + 1, 0 - пусто
+
+public:
+    explicit SpatialFieldStore(double cell_size = 0.25);
+    
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+    void clear();
+    void reserve(size_t count);
+    double getCellSize() const { return cell_size_; }
+    
+    // Вставить или заменить поле с ключом field.position, вернуть сохраненное значение
+    QuantumSoundField& insertOrAssign(const QuantumSoundField& field);
+    
+    // Найти поле по точной позиции (nullptr если нет)
+    QuantumSoundField* find(const SphericalCoord& position);
+    const QuantumSoundField* find(const SphericalCoord& position) const;
+    
+    // Удалить поле по позиции; последний элемент переносится на его место
+    bool erase(const SphericalCoord& position);
+    
+    // Индексы полей в радиусе radius (м) от позиции
+    void queryRadius(const SphericalCoord& position, double radius, std::vector<size_t>& indices) const;
+    
+    // Плотный обход значений. position у значений менять нельзя -
+    // ключ остается тем, с которым поле было вставлено.
+    const std::vector<QuantumSoundField>& values() const { return values_; }
+    
+    // ids()[i] - идентификатор values()[i]. Сохраняется при замене поля с тем
+    // же ключом и при переносе в другой плотный индекс, не повторяется
+    const std::vector<uint64_t>& ids() const { return ids_; }
+    QuantumSoundField& operator[](size_t index) { return values_[index]; }
+    const QuantumSoundField& operator[](size_t index) const { return values_[index]; }
+    std::vector<QuantumSoundField>::iterator begin() { return values_.begin(); }
+    std::vector<QuantumSoundField>::iterator end() { return values_.end(); }
+    std::vector<QuantumSoundField>::const_iterator begin() const { return values_.begin(); }
+    std::vector<QuantumSoundField>::const_iterator end() const { return values_.end(); }
+
+private:
+    Cell cellOf(double x, double y, double z) const;
+    size_t homeSlot(const Cell& cell) const;
+    size_t findSlot(const SphericalCoord& position, const Cell& cell) const;
+    void rehash(size_t slot_count);
+    void insertSlot(uint32_t index);
+};
+
+} // namespace AnantaSound
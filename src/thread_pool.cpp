@@ -0,0 +1,150 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace AnantaSound {
+
+namespace {
+
+// Shared state of one parallelFor call; helpers may outlive the call itself
+struct ParallelForState {
+    size_t count;
+    size_t grain;
+    size_t chunk_count;
+    const std::function<void(size_t, size_t)>* body;
+    std::atomic<size_t> next_chunk{0};
+    std::atomic<size_t> completed_chunks{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;           // First exception thrown by body, under done_mutex
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    
+    void runChunks() {
+        size_t chunk;
+        while ((chunk = next_chunk.fetch_add(1)) < chunk_count) {
+            // After a failure the remaining chunks are only counted, so the
+            // caller can stop waiting and rethrow
+            if (!failed.load()) {
+                size_t begin = chunk * grain;
+                size_t end = std::min(count, begin + grain);
+                try {
+                    (*body)(begin, end);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(done_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+            
+            if (completed_chunks.fetch_add(1) + 1 == chunk_count) {
+                std::lock_guard<std::mutex> lock(done_mutex);
+                done_cv.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t thread_count)
+    : stopping_(false) {
+    if (thread_count == 0) {
+        thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    
+    // The calling thread participates in every parallelFor
+    for (size_t i = 1; i < thread_count; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        stopping_ = true;
+    }
+    queue_cv_.notify_all();
+    
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t ThreadPool::getThreadCount() const {
+    return workers_.size() + 1;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    
+    grain = std::max<size_t>(1, grain);
+    size_t chunk_count = (count + grain - 1) / grain;
+    
+    if (chunk_count == 1 || workers_.empty()) {
+        body(0, count);
+        return;
+    }
+    
+    auto state = std::make_shared<ParallelForState>();
+    state->count = count;
+    state->grain = grain;
+    state->chunk_count = chunk_count;
+    state->body = &body;
+    
+    size_t helpers = std::min(workers_.size(), chunk_count - 1);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        for (size_t i = 0; i < helpers; ++i) {
+            tasks_.emplace_back([state]() { state->runChunks(); });
+        }
+    }
+    if (helpers == 1) {
+        queue_cv_.notify_one();
+    } else {
+        queue_cv_.notify_all();
+    }
+    
+    state->runChunks();
+    
+    std::unique_lock<std::mutex> lock(state->done_mutex);
+    state->done_cv.wait(lock, [&state]() {
+        return state->completed_chunks.load() == state->chunk_count;
+    });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        
+        task();
+    }
+}
+
+} // namespace AnantaSound
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+#include <cstddef>
+
+namespace AnantaSound {
+
+// Пул постоянных рабочих потоков для параллельных циклов ядра.
+// Вызывающий поток тоже выполняет части работы, поэтому вложенные
+// вызовы parallelFor не приводят к взаимной блокировке.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    bool stopping_;
+
+public:
+    // thread_count == 0 - по числу аппаратных потоков
+    explicit ThreadPool(size_t thread_count = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    // Количество потоков, участвующих в работе (включая вызывающий)
+    size_t getThreadCount() const;
+    
+    // Выполнить body(begin, end) для диапазона [0, count) блоками по grain элементов.
+    // Возвращает управление после завершения всех блоков. Первое исключение
+    // из body повторно выбрасывается в вызывающем потоке, оставшиеся блоки
+    // после него пропускаются.
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+    
+    // Общий пул библиотеки
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+};
+
+} // namespace AnantaSound
@@ -3,7 +3,6 @@
 #include <fstream>
 #include <algorithm>
 #include <cmath>
-#include <random>
 
 // Внешние библиотеки для видео (будут добавлены в CMakeLists.txt)
 extern "C" {
@@ -401,12 +400,15 @@ VideoFrame VinylVideoPlayer::applyVinylEffects(const VideoFrame& original_frame)
 void VinylVideoPlayer::applySurfaceNoise(VideoFrame& frame) {
     if (vinyl_params_.surface_noise <= 0.0) return;
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<float> noise_dist(0.0f, vinyl_params_.surface_noise);
+    // One noise sample per RGB pixel, generated as a batch
+    const size_t pixel_count = frame.data.size() / 3;
+    surface_noise_buffer_.resize(pixel_count);
+    surface_noise_stream_.fillNormal(surface_noise_buffer_.data(), pixel_count, 0.0f,
+                                     static_cast<float>(vinyl_params_.surface_noise));
     
-    for (size_t i = 0; i < frame.data.size(); i += 3) { // RGB
-        float noise = noise_dist(gen);
+    for (size_t p = 0; p < pixel_count; ++p) { // RGB
+        const size_t i = 3 * p;
+        float noise = surface_noise_buffer_[p];
         frame.data[i] = std::clamp(frame.data[i] + noise * 255.0f, 0.0f, 255.0f);     // R
         frame.data[i + 1] = std::clamp(frame.data[i + 1] + noise * 255.0f, 0.0f, 255.0f); // G
         frame.data[i + 2] = std::clamp(frame.data[i + 2] + noise * 255.0f, 0.0f, 255.0f); // B
@@ -9,6 +9,8 @@
 #include <mutex>
 #include <chrono>
 
+#include "quantum_random.hpp"
+
 namespace AnantaSound {
 
 // Структура для информации о видео
@@ -93,6 +95,11 @@ public:
     
     VinylParameters vinyl_params_;
     
+private:
+    // Генератор шума поверхности (создается один раз, а не на каждый кадр)
+    RandomStream surface_noise_stream_;
+    std::vector<float> surface_noise_buffer_;
+    
 public:
     VinylVideoPlayer();
     ~VinylVideoPlayer();
@@ -0,0 +1,68 @@
+#include "fast_math.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace AnantaSound;
+
+void test_fast_sincos() {
+    std::cout << "Testing fast sincos kernels..." << std::endl;
+    
+    std::vector<double> phases;
+    for (int i = -5000; i <= 5000; ++i) {
+        phases.push_back(i * 3.7137);
+    }
+    phases.push_back(5.0e7); // beyond the reduction range
+    phases.push_back(-1.0e300);
+    phases.push_back(INFINITY);
+    phases.push_back(NAN);
+    
+    std::vector<double> s(phases.size()), c(phases.size());
+    
+    fastSinCosBatch(phases.data(), s.data(), c.data(), phases.size(), MathAccuracy::HIGH);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (!std::isfinite(phases[i])) {
+            assert(std::isnan(s[i]) && std::isnan(c[i]));
+            continue;
+        }
+        assert(std::abs(s[i] - std::sin(phases[i])) < 1e-13);
+        assert(std::abs(c[i] - std::cos(phases[i])) < 1e-13);
+    }
+    
+    fastSinCosBatch(phases.data(), s.data(), c.data(), phases.size(), MathAccuracy::FAST);
+    for (size_t i = 0; i < phases.size(); ++i) {
+        if (!std::isfinite(phases[i])) continue;
+        assert(std::abs(s[i] - std::sin(phases[i])) < 1e-6);
+        assert(std::abs(c[i] - std::cos(phases[i])) < 1e-6);
+    }
+    
+    auto z = fastExpI(-2.5);
+    assert(std::abs(z - std::exp(std::complex<double>(0.0, -2.5))) < 1e-15);
+    
+    for (double angle = -3.1; angle < 3.1; angle += 0.1) {
+        std::complex<double> w = std::polar(2.0, angle);
+        assert(std::abs(fastArg(w) - std::arg(w)) < 1e-14);
+        assert(std::abs(fastArg(w, MathAccuracy::FAST) - std::arg(w)) < 1e-4);
+    }
+    
+    std::cout << "✓ Fast sincos test passed" << std::endl;
+}
+
+void test_phasor_rotator() {
+    std::cout << "Testing PhasorRotator..." << std::endl;
+    
+    const double start = 0.25;
+    const double step = 2.0 * M_PI * 440.0 / 48000.0;
+    PhasorRotator rotator(start, step);
+    
+    for (int n = 0; n < 480000; ++n) {
+        rotator.advance();
+    }
+    
+    auto expected = std::exp(std::complex<double>(0.0, start + 480000 * step));
+    assert(std::abs(rotator.value() - expected) < 1e-9);
+    assert(std::abs(std::abs(rotator.value()) - 1.0) < 1e-12);
+    
+    std::cout << "✓ PhasorRotator test passed" << std::endl;
+}
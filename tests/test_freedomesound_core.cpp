@@ -1,7 +1,20 @@
 #include "anantasound_core.hpp"
+#include "spatial_field_store.hpp"
+#include "entanglement_graph.hpp"
+#include "slot_map.hpp"
+#include "source_bvh.hpp"
+#include "dome_impulse_response.hpp"
+#include "room_response_cache.hpp"
+#include "thread_pool.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
 
 using namespace AnantaSound;
 
@@ -48,6 +61,184 @@ void test_interference_field() {
     std::cout << "✓ InterferenceField test passed" << std::endl;
 }
 
+void test_interference_field_source_store() {
+    std::cout << "Testing InterferenceField source store..." << std::endl;
+    
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, center, 2.0);
+    
+    const QuantumSoundState states[] = {
+        QuantumSoundState::COHERENT, QuantumSoundState::SUPERPOSITION,
+        QuantumSoundState::ENTANGLED, QuantumSoundState::COLLAPSED, QuantumSoundState::GROUND
+    };
+    
+    std::vector<QuantumSoundField> sources;
+    for (int i = 0; i < 301; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(1.0 + 0.01 * i, 0.3 - 0.002 * i);
+        source.frequency = 100.0 + 7.0 * i;
+        source.quantum_state = states[i % 5];
+        source.position = SphericalCoord(0.5 + 0.01 * i, 0.02 * i, 0.05 * i, 0.0, 0.1 * (i % 7));
+        sources.push_back(source);
+        field.addSourceField(source);
+    }
+    
+    // Reference: direct per-source evaluation
+    auto reference = [&](const SphericalCoord& p) {
+        std::complex<double> total(0.0, 0.0);
+        for (const auto& s : sources) {
+            double dx = p.r * std::sin(p.theta) * std::cos(p.phi) -
+                        s.position.r * std::sin(s.position.theta) * std::cos(s.position.phi);
+            double dy = p.r * std::sin(p.theta) * std::sin(p.phi) -
+                        s.position.r * std::sin(s.position.theta) * std::sin(s.position.phi);
+            double dz = p.height - s.position.height;
+            double phase_delay = 2.0 * M_PI * s.frequency * std::sqrt(dx*dx + dy*dy + dz*dz) / 343.0;
+            std::complex<double> factor(1.0, 0.0);
+            if (s.quantum_state == QuantumSoundState::SUPERPOSITION) factor = {0.707, 0.707};
+            if (s.quantum_state == QuantumSoundState::ENTANGLED) factor = {0.5, 0.866};
+            if (s.quantum_state == QuantumSoundState::COLLAPSED) factor = {0.0, 1.0};
+            total += s.amplitude * factor * std::exp(std::complex<double>(0.0, -phase_delay));
+        }
+        return total;
+    };
+    
+    SphericalCoord probe(1.5, M_PI/3, M_PI/3, 0.0, 0.4);
+    assert(std::abs(field.calculateInterference(probe, 0.0) - reference(probe)) < 1e-9);
+    
+    // Cached gains must follow quantum state changes
+    field.createQuantumEntanglement(0, 4);
+    sources[0].quantum_state = QuantumSoundState::ENTANGLED;
+    sources[4].quantum_state = QuantumSoundState::ENTANGLED;
+    assert(std::abs(field.calculateInterference(probe, 0.0) - reference(probe)) < 1e-9);
+    
+    std::cout << "✓ InterferenceField source store test passed" << std::endl;
+}
+
+void test_interference_field_batch() {
+    std::cout << "Testing InterferenceField batch evaluation..." << std::endl;
+    
+    SphericalCoord center{1.0, M_PI/4, M_PI/4, 1.0};
+    InterferenceField field(InterferenceFieldType::AMPLITUDE_MODULATED, center, 2.0);
+    
+    for (int i = 0; i < 40; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(0.5 + 0.01 * i, 0.1);
+        source.frequency = 200.0 + 13.0 * i;
+        source.quantum_state = (i % 2) ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::COHERENT;
+        source.position = SphericalCoord(1.0 + 0.05 * i, 0.03 * i, 0.07 * i, 0.0, 0.2);
+        field.addSourceField(source);
+    }
+    
+    // 64x64 dome grid, large enough to be split across the thread pool
+    std::vector<SphericalCoord> grid;
+    for (int i = 0; i < 64; ++i) {
+        for (int j = 0; j < 64; ++j) {
+            grid.emplace_back(2.5, (M_PI / 2.0) * i / 63.0, (2.0 * M_PI) * j / 64.0, 0.0, 0.5);
+        }
+    }
+    
+    const double time = 0.0125;
+    auto batch = field.calculateInterferenceBatch(grid, time);
+    assert(batch.size() == grid.size());
+    
+    for (size_t i = 0; i < grid.size(); i += 97) {
+        assert(std::abs(batch[i] - field.calculateInterference(grid[i], time)) < 1e-9);
+    }
+    
+    assert(field.calculateInterferenceBatch({}, time).empty());
+    
+    // A chunk that throws reaches the caller once every chunk is accounted for
+    ThreadPool pool(4);
+    for (size_t failing : {size_t(0), size_t(37)}) {
+        bool caught = false;
+        try {
+            pool.parallelFor(64, 1, [failing](size_t begin, size_t) {
+                if (begin == failing) {
+                    throw std::runtime_error("chunk failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        assert(caught);
+    }
+    std::atomic<size_t> visited{0};
+    pool.parallelFor(64, 1, [&visited](size_t begin, size_t end) { visited += end - begin; });
+    assert(visited == 64);
+    
+    std::cout << "✓ InterferenceField batch test passed" << std::endl;
+}
+
+void test_spatial_field_store() {
+    std::cout << "Testing SpatialFieldStore..." << std::endl;
+    
+    SpatialFieldStore store(0.5);
+    std::vector<SphericalCoord> positions;
+    for (int i = 0; i < 12000; ++i) {
+        positions.emplace_back(0.5 + (i % 97) * 0.05, 0.013 * i, 0.029 * i, 0.0, (i % 13) * 0.2);
+    }
+    
+    for (size_t i = 0; i < positions.size(); ++i) {
+        QuantumSoundField field;
+        field.frequency = static_cast<double>(i);
+        field.position = positions[i];
+        store.insertOrAssign(field);
+    }
+    assert(store.size() == positions.size());
+    
+    // Re-inserting an existing key replaces the value
+    QuantumSoundField replacement;
+    replacement.frequency = -1.0;
+    replacement.position = positions[42];
+    store.insertOrAssign(replacement);
+    assert(store.size() == positions.size());
+    assert(store.find(positions[42])->frequency == -1.0);
+    
+    // Erase every third field, the rest must stay reachable
+    for (size_t i = 0; i < positions.size(); i += 3) {
+        assert(store.erase(positions[i]));
+    }
+    assert(!store.erase(positions[0]));
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const QuantumSoundField* found = store.find(positions[i]);
+        assert((i % 3 == 0) == (found == nullptr));
+        if (found && i != 42) {
+            assert(found->frequency == static_cast<double>(i));
+        }
+    }
+    
+    // Ids follow their values through replacement and swap-removal
+    assert(store.ids().size() == store.size());
+    for (size_t k = 0; k < store.size(); ++k) {
+        const double frequency = store[k].frequency;
+        assert(store.ids()[k] == (frequency < 0.0 ? 43u : static_cast<uint64_t>(frequency) + 1));
+    }
+    
+    // Neighborhood query agrees with a brute-force scan
+    SphericalCoord probe(2.0, 1.0, 2.0, 0.0, 1.0);
+    const double radius = 0.8;
+    auto cartesian = [](const SphericalCoord& p, double& x, double& y, double& z) {
+        x = p.r * std::sin(p.theta) * std::cos(p.phi);
+        y = p.r * std::sin(p.theta) * std::sin(p.phi);
+        z = p.height;
+    };
+    double px, py, pz;
+    cartesian(probe, px, py, pz);
+    size_t expected = 0;
+    for (const auto& field : store.values()) {
+        double x, y, z;
+        cartesian(field.position, x, y, z);
+        if ((x - px) * (x - px) + (y - py) * (y - py) + (z - pz) * (z - pz) <= radius * radius) {
+            ++expected;
+        }
+    }
+    std::vector<size_t> indices;
+    store.queryRadius(probe, radius, indices);
+    assert(expected > 0 && indices.size() == expected);
+    
+    std::cout << "✓ SpatialFieldStore test passed" << std::endl;
+}
+
 void test_dome_acoustic_resonator() {
     std::cout << "Testing DomeAcousticResonator..." << std::endl;
     
@@ -85,3 +276,1121 @@ void test_anantasound_core() {
 }
 
 
+
+void test_anantasound_core_bulk_ingest() {
+    std::cout << "Testing AnantaSoundCore bulk ingest..." << std::endl;
+    
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    
+    std::vector<QuantumSoundField> batch;
+    for (int i = 0; i < 5000; ++i) {
+        SphericalCoord position(1.0 + 0.001 * i, 0.01 * i, 0.02 * i, 0.0, 1.0);
+        batch.push_back(core.createQuantumSoundField(200.0 + i, position, QuantumSoundState::COHERENT));
+    }
+    
+    core.processSoundFields(batch);
+    core.processSoundFields(batch.data(), 100); // re-ingest replaces existing fields
+    
+    auto output = core.getOutputFields();
+    assert(output.size() == batch.size());
+    
+    // Quantum noise N(0, 0.1) is added to both amplitude components
+    double mean = 0.0, variance = 0.0;
+    for (const auto& field : output) {
+        assert(std::abs(field.amplitude.real() - 1.0 - field.amplitude.imag()) < 1e-12);
+        mean += field.amplitude.imag();
+    }
+    mean /= output.size();
+    for (const auto& field : output) {
+        variance += (field.amplitude.imag() - mean) * (field.amplitude.imag() - mean);
+    }
+    variance /= output.size();
+    assert(std::abs(mean) < 0.01);
+    assert(std::abs(std::sqrt(variance) - 0.1) < 0.01);
+    
+    core.shutdown();
+    
+    std::cout << "✓ AnantaSoundCore bulk ingest test passed" << std::endl;
+}
+
+void test_anantasound_core_snapshot() {
+    std::cout << "Testing AnantaSoundCore snapshot..." << std::endl;
+    
+    AnantaSoundCore core(3.0, 2.0);
+    auto initial = core.getSnapshot();
+    assert(initial && initial->fields && initial->fields->empty());
+    
+    assert(core.initialize());
+    auto empty = core.getSnapshot();
+    assert(empty->epoch > initial->epoch);
+    
+    SphericalCoord position(1.0, 0.5, 0.5, 0.0, 1.0);
+    core.processSoundField(core.createQuantumSoundField(440.0, position, QuantumSoundState::COHERENT));
+    
+    // Ingest is not visible until the next update() publishes it
+    assert(core.getSnapshot()->fields->empty());
+    
+    core.update(0.001);
+    auto published = core.getSnapshot();
+    assert(published->epoch == empty->epoch + 1);
+    assert(published->fields->size() == 1);
+    assert(published->statistics.active_fields == 1);
+    assert(published->statistics.coherence_ratio == core.getStatistics().coherence_ratio);
+    
+    // Without ingest after the tick the snapshot shares the tick's fields
+    core.update(0.1);
+    auto ticked = core.getSnapshot();
+    assert(ticked->last_tick && ticked->fields.get() == &ticked->last_tick->fields);
+    
+    // Concurrent updates publish strictly increasing epochs
+    std::atomic<bool> ordered{true};
+    std::thread reader([&]() {
+        uint64_t last = 0;
+        for (int i = 0; i < 20000; ++i) {
+            const uint64_t epoch = core.getSnapshot()->epoch;
+            ordered = ordered && epoch >= last;
+            last = epoch;
+        }
+    });
+    std::vector<std::thread> updaters;
+    for (int t = 0; t < 4; ++t) {
+        updaters.emplace_back([&core]() {
+            for (int i = 0; i < 500; ++i) {
+                core.update(0.001);
+            }
+        });
+    }
+    for (auto& updater : updaters) {
+        updater.join();
+    }
+    reader.join();
+    assert(ordered);
+    assert(core.getSnapshot()->epoch == ticked->epoch + 2000);
+    
+    // Old handles stay valid and unchanged after further publishes
+    core.shutdown();
+    assert(published->fields->size() == 1);
+    assert(core.getSnapshot()->fields->empty());
+    
+    std::cout << "✓ AnantaSoundCore snapshot test passed" << std::endl;
+}
+
+void test_anantasound_core_parallel_update() {
+    std::cout << "Testing AnantaSoundCore parallel update..." << std::endl;
+    
+    auto run = [](uint64_t seed) {
+        AnantaSoundCore core(3.0, 2.0);
+        assert(core.initialize());
+        core.setRandomSeed(seed);
+        
+        std::vector<QuantumSoundField> batch;
+        for (int i = 0; i < 20000; ++i) {
+            SphericalCoord position(1.0 + 0.0001 * i, 0.01 * i, 0.02 * i, 0.0, 1.0);
+            batch.push_back(core.createQuantumSoundField(100.0 + i, position, QuantumSoundState::SUPERPOSITION));
+        }
+        core.processSoundFields(batch);
+        
+        for (int tick = 0; tick < 3; ++tick) {
+            core.update(0.02);
+        }
+        
+        std::vector<QuantumSoundState> states;
+        auto snapshot = core.getSnapshot();
+        for (const auto& field : *snapshot->fields) {
+            states.push_back(field.quantum_state);
+        }
+        return states;
+    };
+    
+    auto first = run(42);
+    auto second = run(42);
+    assert(first == second);
+    
+    // Three passes at 5% leave ~0.95^3 of the fields in superposition
+    size_t remaining = std::count(first.begin(), first.end(), QuantumSoundState::SUPERPOSITION);
+    double ratio = static_cast<double>(remaining) / first.size();
+    assert(std::abs(ratio - 0.857375) < 0.02);
+    
+    assert(run(7) != first);
+    
+    std::cout << "✓ AnantaSoundCore parallel update test passed" << std::endl;
+}
+
+void test_quantum_acoustic_processor() {
+    std::cout << "Testing QuantumAcousticProcessor..." << std::endl;
+    
+    QuantumAcousticProcessor processor(64);
+    assert(processor.getMaxFields() == 64);
+    
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0, 0.0);
+    field.phase = 0.1;
+    field.quantum_state = QuantumSoundState::COHERENT;
+    
+    // The pool honors max_fields
+    size_t accepted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (processor.addField(field)) {
+            ++accepted;
+        }
+    }
+    assert(accepted == 64);
+    
+    // Fields appear after the next tick; published snapshots are immutable
+    std::shared_ptr<const std::vector<QuantumSoundField>> snapshot;
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        snapshot = processor.getProcessedSnapshot();
+        if (snapshot->size() == 64) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assert(snapshot->size() == 64);
+    const std::complex<double> held = (*snapshot)[0].amplitude;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    assert((*snapshot)[0].amplitude == held);
+    
+    // Processing rotates amplitudes without changing their magnitude
+    auto fields = processor.getProcessedFields();
+    assert(fields.size() == 64);
+    assert(std::abs(std::abs(fields[0].amplitude) - 1.0) < 1e-9);
+    assert(fields[0].amplitude != held);
+    
+    // Clearing the pool frees its slots for new fields
+    assert(!processor.addField(field));
+    processor.clearFields();
+    for (int attempt = 0; attempt < 200 && !processor.getProcessedSnapshot()->empty(); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    assert(processor.getProcessedSnapshot()->empty());
+    accepted = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (processor.addField(field)) {
+            ++accepted;
+        }
+    }
+    assert(accepted == 64);
+    
+    // Sharded processing keeps insertion order in the merged result
+    QuantumAcousticProcessor sharded(1000, 4);
+    assert(sharded.getWorkerCount() == 4);
+    for (int i = 0; i < 1000; ++i) {
+        field.frequency = 100.0 + i;
+        field.quantum_state = (i % 2) ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::COHERENT;
+        assert(sharded.addField(field));
+    }
+    for (int attempt = 0; attempt < 200 && sharded.getProcessedSnapshot()->size() < 1000; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    auto merged = sharded.getProcessedFields();
+    assert(merged.size() == 1000);
+    for (size_t i = 0; i < merged.size(); ++i) {
+        assert(merged[i].frequency == 100.0 + i);
+        assert(std::abs(std::abs(merged[i].amplitude) - 1.0) < 1e-9);
+    }
+    
+    std::cout << "✓ QuantumAcousticProcessor test passed" << std::endl;
+}
+
+void test_anantasound_core_fixed_timestep() {
+    std::cout << "Testing AnantaSoundCore fixed timestep..." << std::endl;
+    
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    core.setTickRate(30.0);
+    core.setMaxCatchUpSteps(4);
+    assert(core.getTickRate() == 30.0);
+    
+    // Steps are consumed from the accumulator, the remainder carries over
+    core.update(0.05);
+    auto snapshot = core.getSnapshot();
+    assert(std::abs(snapshot->simulation_time - 1.0 / 30.0) < 1e-12);
+    assert(std::abs(snapshot->interpolation_alpha - 0.5) < 1e-9);
+    core.update(0.02);
+    assert(std::abs(core.getSnapshot()->simulation_time - 2.0 / 30.0) < 1e-12);
+    
+    // A long stall runs at most max_catch_up_steps
+    core.update(10.0);
+    assert(std::abs(core.getSnapshot()->simulation_time - 6.0 / 30.0) < 1e-12);
+    
+    // Decoherence depends on simulated time, not on the tick rate
+    auto survivors = [](double tick_rate, double frame_dt) {
+        AnantaSoundCore sim(3.0, 2.0);
+        assert(sim.initialize());
+        sim.setRandomSeed(3);
+        sim.setTickRate(tick_rate);
+        std::vector<QuantumSoundField> batch;
+        for (int i = 0; i < 20000; ++i) {
+            SphericalCoord position(1.0 + 0.0001 * i, 0.01 * i, 0.02 * i, 0.0, 1.0);
+            batch.push_back(sim.createQuantumSoundField(100.0 + i, position, QuantumSoundState::SUPERPOSITION));
+        }
+        sim.processSoundFields(batch);
+        for (double t = 0.0; t < 0.2 - 1e-9; t += frame_dt) {
+            sim.update(frame_dt);
+        }
+        auto snapshot = sim.getSnapshot();
+        const auto& fields = *snapshot->fields;
+        return static_cast<double>(std::count_if(fields.begin(), fields.end(), [](const QuantumSoundField& f) {
+            return f.quantum_state == QuantumSoundState::SUPERPOSITION;
+        })) / fields.size();
+    };
+    const double expected = std::pow(0.95, 0.2 / 0.016);
+    assert(std::abs(survivors(30.0, 1.0 / 120.0) - expected) < 0.02);
+    assert(std::abs(survivors(120.0, 1.0 / 30.0) - expected) < 0.02);
+    
+    // Excited sources decay after 0.1 s of simulated time at any tick rate
+    auto excitedAfter = [](double tick_rate, double elapsed) {
+        AnantaSoundCore sim(3.0, 2.0);
+        assert(sim.initialize());
+        sim.setTickRate(tick_rate);
+        auto interference = std::make_unique<InterferenceField>(
+            InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(0.0, 0.0, 0.0, 0.0, 0.0), 1.0);
+        const InterferenceField::SourceId source = interference->addSourceField(
+            sim.createQuantumSoundField(440.0, SphericalCoord(1.0, 0.5, 0.5, 0.0, 1.0), QuantumSoundState::EXCITED));
+        auto handle = sim.addInterferenceField(std::move(interference));
+        for (double t = 0.0; t < elapsed - 1e-9; t += 1.0 / 60.0) {
+            sim.update(1.0 / 60.0);
+        }
+        QuantumSoundField state;
+        assert(sim.getInterferenceField(handle)->getSourceField(source, state));
+        return state.quantum_state == QuantumSoundState::EXCITED;
+    };
+    assert(excitedAfter(60.0, 0.05) && excitedAfter(20.0, 0.05));
+    assert(!excitedAfter(60.0, 0.15) && !excitedAfter(20.0, 0.15));
+    
+    // After a catch-up batch the blend starts at the next-to-last step
+    auto before_batch = core.getSnapshot()->last_tick;
+    core.update(3.0 / 30.0);
+    auto batch = core.getSnapshot();
+    assert(batch->previous_tick && batch->previous_tick != before_batch);
+    assert(batch->last_tick != batch->previous_tick);
+    
+    // Interpolated fields blend the previous and current tick
+    SphericalCoord position(1.0, 0.5, 0.5, 0.0, 1.0);
+    QuantumSoundField field = core.createQuantumSoundField(440.0, position, QuantumSoundState::COHERENT);
+    field.amplitude = 1.0;
+    core.setRandomSeed(0);
+    core.processSoundField(field);
+    core.update(1.0 / 30.0);
+    field.amplitude = 3.0;
+    core.processSoundField(field);
+    core.update(1.5 / 30.0);
+    
+    // Ingest between ticks changes the live fields but not the blend, which
+    // runs from the previous tick to the last one
+    field.amplitude = 7.0;
+    core.processSoundField(field);
+    core.update(0.0);
+    auto blended = core.getSnapshot();
+    auto interpolated = core.getInterpolatedFields();
+    assert(interpolated.size() == 1);
+    assert(blended->previous_tick && blended->previous_tick->fields.size() == 1);
+    assert(blended->last_tick && blended->last_tick->ids == blended->previous_tick->ids);
+    const double alpha = blended->interpolation_alpha;
+    assert(alpha >= 0.0 && alpha < 1.0);
+    const double before = blended->previous_tick->fields[0].amplitude.real();
+    const double after = blended->last_tick->fields[0].amplitude.real();
+    assert(std::abs(before - after) > 1.0);
+    assert(std::abs((*blended->fields)[0].amplitude.real() - after) > 1.0);
+    assert(std::abs(interpolated[0].amplitude.real() - (before + alpha * (after - before))) < 1e-9);
+    
+    std::cout << "✓ AnantaSoundCore fixed timestep test passed" << std::endl;
+}
+
+void test_entanglement_graph() {
+    std::cout << "Testing entanglement graph..." << std::endl;
+    
+    EntanglementGraph graph;
+    assert(graph.addEdge(0, 1));
+    assert(!graph.addEdge(1, 0)); // duplicates are ignored
+    assert(graph.addEdge(1, 2));
+    assert(graph.addEdge(5, 6));
+    assert(!graph.addEdge(3, 3));
+    graph.addNode(3);
+    assert(graph.getEdgeCount() == 3);
+    
+    assert(graph.clusterOf(0) == graph.clusterOf(2));
+    assert(graph.clusterOf(0) != graph.clusterOf(5));
+    assert(graph.clusterMembers(3).size() == 1);
+    assert(graph.clusterMembers(1).size() == 3);
+    
+    size_t degree = 0;
+    graph.neighbors(1, degree);
+    assert(degree == 2);
+    
+    // Removing the bridge splits the cluster
+    graph.removeNode(1);
+    assert(graph.getEdgeCount() == 1);
+    assert(graph.clusterOf(0) != graph.clusterOf(2));
+    assert(graph.clusterOf(5) == graph.clusterOf(6));
+    
+    // Batched removals are purged lazily; a reused id comes back without its old edges
+    EntanglementGraph star;
+    for (EntanglementGraph::NodeId leaf = 1; leaf <= 100; ++leaf) {
+        star.addEdge(0, leaf);
+    }
+    for (EntanglementGraph::NodeId leaf = 1; leaf <= 50; ++leaf) {
+        star.removeNode(leaf);
+    }
+    assert(!star.hasEdge(0, 1) && star.hasEdge(0, 51));
+    star.neighbors(0, degree);
+    assert(degree == 50);
+    star.removeNode(0);
+    star.addNode(0);
+    assert(star.getEdgeCount() == 0);
+    assert(star.clusterMembers(0).size() == 1);
+    
+    // InterferenceField: stable ids, O(1) removal and cluster-wide updates
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 5.0);
+    std::vector<InterferenceField::SourceId> ids;
+    for (int i = 0; i < 6; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(1.0, 0.0);
+        source.frequency = 100.0 * (i + 1);
+        source.quantum_state = QuantumSoundState::COHERENT;
+        ids.push_back(field.addSourceField(source));
+    }
+    
+    field.createQuantumEntanglement(0, 1);
+    field.createQuantumEntanglement(1, 0);
+    assert(field.entangleSources(ids[1], ids[2]));
+    assert(field.entangleSources(ids[4], ids[5]));
+    assert(field.getEntangledPairsCount() == 3);
+    assert(field.getEntanglementClusterMembers(ids[0]).size() == 3);
+    
+    field.setClusterQuantumState(ids[2], QuantumSoundState::COLLAPSED);
+    QuantumSoundField stored;
+    for (int i : {0, 1, 2}) {
+        assert(field.getSourceField(ids[i], stored));
+        assert(stored.quantum_state == QuantumSoundState::COLLAPSED);
+    }
+    assert(field.getSourceField(ids[4], stored) && stored.quantum_state == QuantumSoundState::ENTANGLED);
+    
+    // Removal keeps the other ids valid and drops the removed source's pairs
+    assert(field.removeSourceField(ids[0]));
+    assert(!field.removeSourceField(ids[0]));
+    assert(field.getSourceCount() == 5);
+    assert(field.getEntangledPairsCount() == 2);
+    assert(field.getSourceField(ids[5], stored) && stored.frequency == 600.0);
+    assert(field.getEntanglementCluster(ids[1]) == field.getEntanglementCluster(ids[2]));
+    assert(!field.getEntanglementCluster(ids[0]).isValid());
+    
+    std::cout << "✓ Entanglement graph test passed" << std::endl;
+}
+
+void test_slot_map() {
+    std::cout << "Testing SlotMap..." << std::endl;
+    
+    SlotMap<int> map;
+    std::vector<SlotHandle> handles;
+    for (int i = 0; i < 10; ++i) {
+        handles.push_back(map.insert(i));
+    }
+    
+    assert(map.erase(handles[3]));
+    assert(!map.erase(handles[3]));
+    assert(map.size() == 9);
+    assert(map.get(handles[3]) == nullptr);
+    for (int i : {0, 1, 2, 4, 9}) {
+        assert(*map.get(handles[i]) == i);
+    }
+    
+    // The freed slot is reused with a new generation
+    SlotHandle reused = map.insert(42);
+    assert(reused.index == handles[3].index);
+    assert(reused != handles[3]);
+    assert(map.get(handles[3]) == nullptr);
+    assert(*map.get(reused) == 42);
+    
+    // Dense iteration sees every live value once
+    int sum = 0;
+    for (int value : map) sum += value;
+    assert(sum == 45 - 3 + 42);
+    assert(map.handleAt(map.denseIndexOf(handles[9])) == handles[9]);
+    
+    // Ordered removal keeps the remaining values in place order and their handles valid
+    SlotMap<int> ordered;
+    std::vector<SlotHandle> ordered_handles;
+    for (int i = 0; i < 5; ++i) {
+        ordered_handles.push_back(ordered.insert(i));
+    }
+    ordered.eraseDenseOrdered(1);
+    assert((ordered.values() == std::vector<int>{0, 2, 3, 4}));
+    assert(ordered.get(ordered_handles[1]) == nullptr);
+    for (int i : {0, 2, 3, 4}) {
+        assert(*ordered.get(ordered_handles[i]) == i);
+        assert(ordered.handleAt(ordered.denseIndexOf(ordered_handles[i])) == ordered_handles[i]);
+    }
+    
+    // Core interference fields are addressed by handle
+    AnantaSoundCore core(3.0, 2.0);
+    assert(core.initialize());
+    auto first = core.addInterferenceField(std::make_unique<InterferenceField>(
+        InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 1.0));
+    auto second = core.addInterferenceField(std::make_unique<InterferenceField>(
+        InterferenceFieldType::DESTRUCTIVE, SphericalCoord(), 2.0));
+    InterferenceField* second_field = core.getInterferenceField(second);
+    assert(second_field != nullptr);
+    assert(core.removeInterferenceField(first));
+    assert(core.getInterferenceField(first) == nullptr);
+    assert(core.getInterferenceField(second) == second_field);
+    assert(core.getInterferenceFieldCount() == 1);
+    core.shutdown();
+    
+    std::cout << "✓ SlotMap test passed" << std::endl;
+}
+
+void test_interference_source_tree() {
+    std::cout << "Testing InterferenceField source tree..." << std::endl;
+    
+    // Dense clusters of co-located, same-frequency sources plus a weak
+    // scattered background
+    InterferenceField field(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 10.0);
+    RandomStream random(11);
+    double total_gain = 0.0;
+    for (int cluster = 0; cluster < 8; ++cluster) {
+        SphericalCoord centre(5.0, 0.3 + 0.3 * cluster, 0.7 * cluster, 0.0, 0.5 * cluster);
+        for (int i = 0; i < 250; ++i) {
+            QuantumSoundField source;
+            source.amplitude = std::complex<double>(random.nextUniform(0.5, 1.0), random.nextUniform(-0.5, 0.5));
+            source.frequency = 200.0 + 50.0 * cluster;
+            source.quantum_state = QuantumSoundState::COHERENT;
+            source.position = centre;
+            field.addSourceField(source);
+            total_gain += std::abs(source.amplitude);
+        }
+    }
+    for (int i = 0; i < 2000; ++i) {
+        QuantumSoundField source;
+        source.amplitude = std::complex<double>(1e-5, 0.0);
+        source.frequency = random.nextUniform(100.0, 2000.0);
+        source.quantum_state = QuantumSoundState::COHERENT;
+        source.position = SphericalCoord(random.nextUniform(1.0, 9.0), random.nextUniform(0.0, M_PI),
+                                         random.nextUniform(0.0, 2.0 * M_PI), 0.0, random.nextUniform(0.0, 4.0));
+        field.addSourceField(source);
+        total_gain += 1e-5;
+    }
+    
+    std::vector<SphericalCoord> receivers;
+    for (int i = 0; i < 32; ++i) {
+        receivers.emplace_back(2.0 + 0.1 * i, 0.05 * i, 0.2 * i, 0.0, 1.0);
+    }
+    auto exact = field.calculateInterferenceBatch(receivers, 0.0);
+    
+    const double tolerance = 1e-3;
+    field.setApproximationTolerance(tolerance);
+    auto approximate = field.calculateInterferenceBatch(receivers, 0.0);
+    for (size_t i = 0; i < receivers.size(); ++i) {
+        assert(std::abs(approximate[i] - exact[i]) <= tolerance * total_gain);
+        assert(std::abs(field.calculateInterference(receivers[i], 0.0) - approximate[i]) < 1e-12);
+    }
+    
+    // Co-located clusters collapse to single phasors and the background is culled
+    SourceBvh tree;
+    std::vector<double> x, y, z, gr, gi, k;
+    for (int i = 0; i < 4096; ++i) {
+        x.push_back(i < 2048 ? 3.0 : -3.0);
+        y.push_back(0.0);
+        z.push_back(1.0);
+        gr.push_back(i < 4000 ? 1.0 : 1e-9);
+        gi.push_back(0.0);
+        k.push_back(i < 2048 ? 5.0 : 7.0);
+    }
+    tree.build(x.data(), y.data(), z.data(), gr.data(), gi.data(), k.data(), x.size());
+    SourceBvh::EvaluationStats stats;
+    std::complex<double> sum = tree.evaluate(0.0, 0.0, 0.0, 1e-6, MathAccuracy::HIGH, &stats);
+    std::complex<double> expected = 2048.0 * std::exp(std::complex<double>(0.0, -5.0 * std::sqrt(10.0))) +
+                                    1952.0 * std::exp(std::complex<double>(0.0, -7.0 * std::sqrt(10.0)));
+    assert(std::abs(sum - expected) < 1e-6 * 4000.0);
+    assert(stats.exact_sources < 64);
+    
+    // Changing a source invalidates the tree
+    field.setApproximationTolerance(0.0);
+    QuantumSoundField loud;
+    loud.amplitude = 100.0;
+    loud.frequency = 440.0;
+    loud.quantum_state = QuantumSoundState::COHERENT;
+    field.addSourceField(loud);
+    std::complex<double> direct = field.calculateInterference(receivers[0], 0.0);
+    field.setApproximationTolerance(tolerance);
+    assert(std::abs(field.calculateInterference(receivers[0], 0.0) - direct) <= tolerance * (total_gain + 100.0));
+    
+    std::cout << "✓ InterferenceField source tree test passed" << std::endl;
+}
+
+void test_dome_modal_solver() {
+    std::cout << "Testing DomeModalSolver..." << std::endl;
+    
+    // Reference values of Bessel functions and their derivative zeros
+    assert(std::abs(besselJ(0, 1.0) - 0.7651976865579666) < 1e-12);
+    assert(std::abs(besselJ(5, 10.0) + 0.2340615281867936) < 1e-12);
+    
+    // Large arguments (big domes, high frequencies) keep full accuracy:
+    // n, x, J_n(x), J'_n(x)
+    const double large_arguments[][4] = {
+        {0, 200.0, -0.015437439930565092, 0.054304538182378223},
+        {1, 200.0, -0.054304538182378223, -0.0151659172396532},
+        {50, 200.0, 0.015693898978573084, -0.053437821914950582},
+        {300, 200.0, 1.3941183954632936e-30, 1.5614354299366451e-30},
+        {0, 500.0, -0.034100556880731998, -0.010472613470372293},
+        {1, 500.0, 0.010472613470372293, -0.034121502107672743},
+        {50, 500.0, -0.021144561727588722, -0.028688152329789518},
+        {300, 500.0, -0.0029540008506893707, -0.031823227719632449},
+        {0, 1000.0, 0.024786686152420175, -0.0047283119070895239},
+        {1, 1000.0, 0.0047283119070895239, 0.024781957840513085},
+        {50, 1000.0, -0.0033360489606152764, 0.024996115149198258},
+        {300, 1000.0, 0.0004678280387912479, -0.02463960624360017},
+    };
+    for (const auto& row : large_arguments) {
+        const int n = static_cast<int>(row[0]);
+        assert(std::abs(besselJ(n, row[1]) - row[2]) < 1e-12);
+        assert(std::abs(besselJPrime(n, row[1]) - row[3]) < 1e-12);
+    }
+    assert(std::abs(sphericalBesselJ(0, 2.0) - std::sin(2.0) / 2.0) < 1e-12);
+    double j3 = (15.0 / 125.0 - 6.0 / 5.0) * std::sin(5.0) / 5.0 - (15.0 / 25.0 - 1.0) * std::cos(5.0) / 5.0;
+    assert(std::abs(sphericalBesselJ(3, 5.0) - j3) < 1e-12);
+    
+    auto j0 = besselJPrimeZeros(0, 8.0);
+    assert(j0.size() == 2);
+    assert(std::abs(j0[0] - 3.8317059702075123) < 1e-10);
+    assert(std::abs(j0[1] - 7.0155866698156187) < 1e-10);
+    auto j1 = besselJPrimeZeros(1, 6.0);
+    assert(j1.size() == 2);
+    assert(std::abs(j1[0] - 1.8411837813406593) < 1e-10);
+    assert(std::abs(j1[1] - 5.3314427735250325) < 1e-10);
+    assert(std::abs(besselJPrimeZeros(2, 4.0)[0] - 3.0542369282271403) < 1e-10);
+    assert(std::abs(besselJPrimeZeros(10, 12.0)[0] - 11.770876674955582) < 1e-9);
+    
+    assert(std::abs(sphericalBesselJPrimeZeros(0, 5.0)[0] - 4.4934094579090642) < 1e-10);
+    assert(std::abs(sphericalBesselJPrimeZeros(1, 3.0)[0] - 2.0815759778181763) < 1e-10);
+    assert(std::abs(sphericalBesselJPrimeZeros(2, 4.0)[0] - 3.3420936573656936) < 1e-10);
+    
+    // Cylinder: lowest mode is the (1,1,0) tangential mode
+    auto cylinder = DomeModalSolver::computeModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 200.0);
+    assert(!cylinder.empty());
+    assert(std::abs(cylinder[0].frequency - 343.0 / (2.0 * M_PI) * 1.8411837813406593 / 3.0) < 1e-6);
+    assert(cylinder[0].order == 1 && cylinder[0].radial == 1 && cylinder[0].axial == 0);
+    assert(cylinder[0].multiplicity == 2);
+    for (size_t i = 1; i < cylinder.size(); ++i) {
+        assert(cylinder[i - 1].frequency <= cylinder[i].frequency);
+        assert(cylinder[i].frequency <= 200.0);
+    }
+    
+    // Mode count follows Weyl's law N ~ 4π V f^3 / (3 c^3) at high frequency
+    auto dense = DomeModalSolver::computeModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 1000.0);
+    size_t mode_count = 0;
+    for (const auto& mode : dense) {
+        mode_count += mode.multiplicity;
+    }
+    double volume = M_PI * 9.0 * 2.0;
+    double weyl = 4.0 * M_PI * volume * std::pow(1000.0 / 343.0, 3) / 3.0;
+    assert(dense.size() > 300);
+    assert(mode_count > 0.7 * weyl && mode_count < 1.3 * weyl);
+    
+    // Hemisphere: lowest mode from j'_1, degeneracy l + 1
+    auto hemisphere = DomeModalSolver::computeModes(DomeShapeModel::HEMISPHERE, 3.0, 0.0, 300.0);
+    assert(!hemisphere.empty());
+    assert(hemisphere[0].order == 1 && hemisphere[0].multiplicity == 2);
+    assert(std::abs(hemisphere[0].frequency - 343.0 / (2.0 * M_PI) * 2.0815759778181763 / 3.0) < 1e-6);
+    
+    // Cache: same geometry returns the same list, lower ceilings a prefix
+    DomeModalSolver::clearCache();
+    auto cached = DomeModalSolver::getModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 1000.0);
+    assert(DomeModalSolver::getModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 1000.0) == cached);
+    auto prefix = DomeModalSolver::getModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 200.0);
+    assert(prefix->size() == cylinder.size());
+    assert(DomeModalSolver::getCacheSize() == 1);
+    
+    // Eviction is least-recently-used: a geometry in use survives a full cache
+    for (int i = 1; i < 16; ++i) {
+        DomeModalSolver::getModes(DomeShapeModel::SPHERE, 1.0 + 0.1 * i, 0.0, 100.0);
+        assert(DomeModalSolver::getModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 1000.0) == cached);
+    }
+    assert(DomeModalSolver::getCacheSize() == 16);
+    auto first_sphere = DomeModalSolver::getModes(DomeShapeModel::SPHERE, 1.1, 0.0, 100.0);
+    DomeModalSolver::getModes(DomeShapeModel::SPHERE, 0.5, 0.0, 100.0);
+    assert(DomeModalSolver::getCacheSize() == 16);
+    assert(DomeModalSolver::getModes(DomeShapeModel::CYLINDER, 3.0, 2.0, 1000.0) == cached);
+    assert(DomeModalSolver::getModes(DomeShapeModel::SPHERE, 1.1, 0.0, 100.0) == first_sphere);
+    DomeModalSolver::clearCache();
+    
+    DomeAcousticResonator resonator(3.0, 2.0);
+    assert(resonator.getSchroederFrequency() > 0.0);
+    assert(resonator.getResonantFrequencies().size() > 5);
+    assert(resonator.calculateEigenFrequencies(200.0).size() == cylinder.size());
+    resonator.setShapeModel(DomeShapeModel::HEMISPHERE);
+    assert(resonator.getModes(300.0)->size() == hemisphere.size());
+    
+    std::cout << "✓ DomeModalSolver test passed" << std::endl;
+}
+
+void test_acoustic_material() {
+    std::cout << "Testing AcousticMaterial..." << std::endl;
+    
+    assert(octaveBandFrequencies().size() == 10);
+    assert(thirdOctaveBandFrequencies().size() == 30);
+    
+    // DAGA presets
+    assert(std::abs(AcousticMaterial::preset(MaterialPreset::STANDARD).absorptionAt(440.0) - 0.1) < 1e-12);
+    assert(std::abs(AcousticMaterial::preset(MaterialPreset::ACOUSTIC).absorptionAt(90.0) - 0.3) < 1e-12);
+    assert(std::abs(AcousticMaterial::preset(MaterialPreset::REFLECTIVE).absorptionAt(5000.0) - 0.05) < 1e-12);
+    assert(std::abs(AcousticMaterial::preset(MaterialPreset::ABSORBENT).absorptionAt(20.0) - 0.5) < 1e-12);
+    assert(AcousticMaterial::preset(MaterialPreset::ABSORBENT).getDiffusion() == 0.8);
+    
+    // Log-frequency interpolation: halfway between 250 and 1000 Hz on a log axis is 500 Hz
+    AcousticMaterial panel("Panel", {1000.0, 250.0, 3000.0}, {0.6, 0.2, 0.9});
+    assert(panel.getBandFrequencies().front() == 250.0);
+    assert(std::abs(panel.absorptionAt(500.0) - 0.4) < 1e-12);
+    assert(std::abs(panel.absorptionAt(100.0) - 0.2) < 1e-12);
+    assert(std::abs(panel.absorptionAt(8000.0) - 0.9) < 1e-12);
+    
+    // Batch evaluation matches scalar on uniform and non-uniform tables
+    AcousticMaterial octave = panel.resampled(octaveBandFrequencies());
+    std::vector<double> frequencies;
+    for (double f = 10.0; f < 24000.0; f *= 1.07) {
+        frequencies.push_back(f);
+    }
+    auto batch = octave.absorptionAt(frequencies);
+    auto irregular = panel.absorptionAt(frequencies);
+    for (size_t i = 0; i < frequencies.size(); ++i) {
+        assert(std::abs(batch[i] - octave.absorptionAt(frequencies[i])) < 1e-9);
+        assert(std::abs(irregular[i] - panel.absorptionAt(frequencies[i])) < 1e-12);
+    }
+    
+    // Invalid frequencies clamp to the lowest band on both paths
+    std::vector<double> invalid = {std::nan(""), 0.0, -440.0};
+    for (const AcousticMaterial* material : {&octave, &panel}) {
+        const double lowest = material->absorptionAt(material->getBandFrequencies().front());
+        for (double absorption : material->absorptionAt(invalid)) {
+            assert(absorption == lowest);
+        }
+        assert(material->absorptionAt(std::nan("")) == lowest);
+    }
+    
+    // Sabine and Eyring agree for small absorption, Eyring is shorter for large
+    double volume = 1000.0, surface = 600.0;
+    double sabine = sabineReverbTime(volume, surface, 0.05);
+    double eyring = eyringReverbTime(volume, surface, 0.05);
+    assert(std::abs(sabine - 0.161 * volume / (surface * 0.05)) < 1e-12);
+    assert(eyring < sabine && eyring > 0.95 * sabine);
+    assert(eyringReverbTime(volume, surface, 0.5) < 0.75 * sabineReverbTime(volume, surface, 0.5));
+    auto band_times = octave.bandReverbTimes(volume, surface, ReverbFormula::EYRING);
+    assert(band_times.size() == octave.getBandFrequencies().size());
+    assert(band_times.front() > band_times.back());
+    
+    // Resonator: properties interpolate instead of requiring an exact key
+    DomeAcousticResonator resonator(5.0, 3.0);
+    double base = resonator.calculateReverbTime(441.0);
+    std::map<double, double> properties;
+    properties[440.0] = 1.0;
+    properties[880.0] = 0.5;
+    resonator.setMaterialProperties(properties);
+    assert(std::abs(resonator.calculateReverbTime(440.0) - base) < 1e-12);
+    assert(resonator.calculateReverbTime(441.0) < base);
+    assert(std::abs(resonator.calculateReverbTime(std::sqrt(440.0 * 880.0)) - 0.75 * base) < 1e-9);
+    
+    // T60 moves the Schroeder frequency, so the modal region follows the material
+    auto refreshed = [&resonator]() {
+        return resonator.getResonantFrequencies() == resonator.calculateEigenFrequencies();
+    };
+    size_t modal_count = resonator.getResonantFrequencies().size();
+    assert(refreshed());
+    resonator.setMaterialProperties({});
+    assert(refreshed() && resonator.getResonantFrequencies().size() > modal_count);
+    resonator.setMaterial(AcousticMaterial::preset(MaterialPreset::ABSORBENT));
+    assert(refreshed());
+    double absorbent = resonator.calculateReverbTime(1000.0);
+    assert(std::abs(absorbent - sabineReverbTime(resonator.getVolume(), resonator.getSurfaceArea(), 0.5)) < 1e-12);
+    resonator.setReverbFormula(ReverbFormula::EYRING);
+    assert(refreshed());
+    assert(resonator.calculateReverbTime(1000.0) < absorbent);
+    auto times = resonator.calculateReverbTimes({125.0, 1000.0, 8000.0});
+    assert(times.size() == 3 && std::abs(times[1] - resonator.calculateReverbTime(1000.0)) < 1e-9);
+    
+    std::cout << "✓ AcousticMaterial test passed" << std::endl;
+}
+
+void test_room_eq() {
+    std::cout << "Testing room EQ designer..." << std::endl;
+    
+    const double sample_rate = 48000.0;
+    
+    // Peaking section reaches its gain at the center and is flat far away
+    BiquadCoefficients peak = BiquadCoefficients::peaking(100.0, -9.0, 4.0, sample_rate);
+    assert(std::abs(peak.magnitudeDb(100.0, sample_rate) + 9.0) < 1e-9);
+    assert(std::abs(peak.magnitudeDb(5000.0, sample_rate)) < 0.05);
+    
+    // Steady-state sine at the center is attenuated by the cascade gain
+    BiquadCascade cascade = BiquadCascade::fromParametricBands({{100.0, -9.0, 4.0}, {400.0, 3.0, 2.0}}, sample_rate);
+    double expected_db = cascade.magnitudeDb(100.0, sample_rate);
+    std::vector<float> signal(48000);
+    std::vector<double> signal_double(signal.size());
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal_double[i] = std::sin(2.0 * M_PI * 100.0 * i / sample_rate);
+        signal[i] = static_cast<float>(signal_double[i]);
+    }
+    BiquadCascade cascade_double = cascade;
+    cascade.process(signal.data(), signal.size());
+    cascade_double.process(signal_double.data(), signal_double.size());
+    double peak_level = 0.0;
+    for (size_t i = signal.size() / 2; i < signal.size(); ++i) {
+        peak_level = std::max(peak_level, std::abs(static_cast<double>(signal[i])));
+        assert(std::abs(signal[i] - signal_double[i]) < 1e-5);
+    }
+    assert(std::abs(20.0 * std::log10(peak_level) - expected_db) < 0.05);
+    
+    // Fitting recovers a synthetic deviation made of peaks
+    std::vector<double> grid;
+    for (double f = 20.0; f <= 400.0; f *= std::exp2(1.0 / 24.0)) {
+        grid.push_back(f);
+    }
+    std::vector<ParametricEqBand> room = {{45.0, 8.0, 5.0}, {90.0, 6.0, 3.0}, {210.0, 4.0, 6.0}};
+    std::vector<double> deviation(grid.size(), 0.0);
+    for (size_t i = 0; i < grid.size(); ++i) {
+        for (const auto& band : room) {
+            deviation[i] += BiquadCoefficients::peaking(band.frequency, band.gain_db, band.q, sample_rate)
+                                .magnitudeDb(grid[i], sample_rate);
+        }
+    }
+    RoomEqSettings settings;
+    RoomEqResult fit = fitParametricEq(grid, deviation, settings);
+    assert(!fit.bands.empty() && fit.bands.size() <= settings.max_bands);
+    assert(fit.rms_error_after_db < 0.1 * fit.rms_error_before_db);
+    for (const auto& band : fit.bands) {
+        assert(band.gain_db >= settings.min_gain_db - 1e-9 && band.gain_db <= settings.max_gain_db + 1e-9);
+        assert(band.q >= settings.min_q - 1e-9 && band.q <= settings.max_q + 1e-9);
+    }
+    
+    // A deep dip is raised by max_gain_db in total, not per band, and the
+    // fit stops once no band can reduce it further
+    std::vector<double> dip(grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        dip[i] = BiquadCoefficients::peaking(100.0, -20.0, 4.0, sample_rate).magnitudeDb(grid[i], sample_rate);
+    }
+    RoomEqResult dip_fit = fitParametricEq(grid, dip, settings);
+    BiquadCascade dip_cascade = BiquadCascade::fromParametricBands(dip_fit.bands, sample_rate);
+    assert(!dip_fit.bands.empty() && dip_fit.bands.size() < settings.max_bands);
+    assert(dip_cascade.magnitudeDb(100.0, sample_rate) > settings.max_gain_db - 0.5);
+    for (double f = 20.0; f <= 400.0; f *= std::exp2(1.0 / 96.0)) {
+        assert(dip_cascade.magnitudeDb(f, sample_rate) <= settings.max_gain_db + 0.05);
+    }
+    for (size_t i = 0; i < grid.size(); ++i) {
+        assert(dip_cascade.magnitudeDb(grid[i], sample_rate) <= settings.max_gain_db + 1e-6);
+    }
+    assert(dip_fit.rms_error_after_db < dip_fit.rms_error_before_db);
+    
+    // Dome correction from the modal response, then a fast re-fit after
+    // the absorption changes
+    DomeAcousticResonator resonator(6.0, 4.0);
+    resonator.setMaterial(AcousticMaterial::preset(MaterialPreset::REFLECTIVE));
+    resonator.optimizeFrequencyResponse({});
+    RoomEqResult correction = resonator.getCorrection();
+    assert(!correction.bands.empty());
+    assert(correction.rms_error_after_db < correction.rms_error_before_db);
+    assert(resonator.getCorrectionFilters().size() == correction.bands.size());
+    
+    resonator.setMaterial(AcousticMaterial::preset(MaterialPreset::STANDARD));
+    resonator.optimizeFrequencyResponse({});
+    assert(resonator.getCorrection().rms_error_after_db < resonator.getCorrection().rms_error_before_db);
+    
+    std::cout << "✓ Room EQ designer test passed" << std::endl;
+}
+
+void test_dome_impulse_response() {
+    std::cout << "Testing DomeImpulseResponseGenerator..." << std::endl;
+    
+    DomeAcousticResonator resonator(8.0, 8.0);
+    resonator.setShapeModel(DomeShapeModel::HEMISPHERE);
+    resonator.setMaterial(AcousticMaterial::preset(MaterialPreset::STANDARD));
+    
+    ImpulseResponseSettings settings;
+    settings.duration = 1.5;
+    DomeImpulseResponseGenerator generator(resonator, settings);
+    
+    // Source and receiver 1.5 m above the floor, 4 m apart
+    SphericalCoord source(2.0, M_PI / 2.0, 0.0, 0.0, 1.5);
+    SphericalCoord receiver(2.0, M_PI / 2.0, M_PI, 0.0, 1.5);
+    ImpulseResponse ir = generator.generate(source, receiver);
+    assert(ir.sample_rate == settings.sample_rate);
+    assert(ir.samples.size() == static_cast<size_t>(1.5 * settings.sample_rate));
+    
+    // Direct sound: amplitude 1/d split over two samples at d/c
+    double direct_position = 4.0 / settings.speed_of_sound * settings.sample_rate;
+    size_t direct_index = static_cast<size_t>(direct_position);
+    for (size_t i = 0; i + 1 < direct_index; ++i) {
+        assert(ir.samples[i] == 0.0f);
+    }
+    assert(std::abs(ir.samples[direct_index] + ir.samples[direct_index + 1] - 0.25) < 1e-6);
+    
+    // Floor image at distance 5 m (4 m horizontal, 3 m vertical)
+    size_t floor_index = static_cast<size_t>(5.0 / settings.speed_of_sound * settings.sample_rate);
+    assert(ir.samples[floor_index] + ir.samples[floor_index + 1] > 0.1);
+    
+    // Late decay follows the resonator RT60 (Schroeder integral, T20 fit)
+    double expected_rt60 = resonator.calculateReverbTime(1000.0);
+    std::vector<double> decay(ir.samples.size() + 1, 0.0);
+    for (size_t i = ir.samples.size(); i-- > 0;) {
+        decay[i] = decay[i + 1] + static_cast<double>(ir.samples[i]) * ir.samples[i];
+    }
+    size_t t5 = 0, t25 = 0;
+    for (size_t i = 0; i < ir.samples.size(); ++i) {
+        double level = 10.0 * std::log10(decay[i] / decay[0]);
+        if (t5 == 0 && level <= -5.0) t5 = i;
+        if (t25 == 0 && level <= -25.0) { t25 = i; break; }
+    }
+    assert(t5 > 0 && t25 > t5);
+    double measured_rt60 = 3.0 * (t25 - t5) / settings.sample_rate;
+    assert(measured_rt60 > 0.7 * expected_rt60 && measured_rt60 < 1.3 * expected_rt60);
+    
+    // Sphere: first-order shell reflections are exact image paths, the same
+    // ones RoomResponseCache finds for the pair
+    DomeAcousticResonator sphere(6.0, 6.0);
+    sphere.setShapeModel(DomeShapeModel::SPHERE);
+    sphere.setMaterial(AcousticMaterial::preset(MaterialPreset::STANDARD));
+    ImpulseResponseSettings sphere_settings;
+    sphere_settings.duration = 0.1;
+    sphere_settings.ray_count = 0;
+    DomeImpulseResponseGenerator sphere_generator(sphere, sphere_settings);
+    SphericalCoord sphere_source(2.0, M_PI / 3.0, 0.0, 0.0, 1.0);
+    SphericalCoord sphere_receiver(3.0, M_PI / 2.0, 2.0, 0.0, -0.5);
+    ImpulseResponse sphere_ir = sphere_generator.generate(sphere_source, sphere_receiver);
+    const double s_point[3] = {2.0 * std::sin(M_PI / 3.0), 0.0, 1.0};
+    const double r_point[3] = {3.0 * std::cos(2.0), 3.0 * std::sin(2.0), -0.5};
+    RoomTransfer shell = RoomResponseCache(sphere).computeTransfer(s_point, r_point);
+    assert(!shell.taps.empty());
+    for (const ReflectionTap& tap : shell.taps) {
+        assert(tap.kind == ReflectionKind::SHELL);
+        if (tap.delay >= sphere_settings.early_duration) {
+            continue;
+        }
+        // Both modules place the path at the same time; the broadband loss
+        // is each module's own mean absorption
+        const size_t index = static_cast<size_t>(tap.delay * sphere_settings.sample_rate);
+        const double deposited = sphere_ir.samples[index] + sphere_ir.samples[index + 1];
+        assert(std::abs(deposited - tap.gain) < 0.05 * tap.gain);
+    }
+    
+    // Deterministic output
+    ImpulseResponse again = generator.generate(source, receiver);
+    assert(again.samples == ir.samples);
+    
+    // 64 receivers across the dome in parallel
+    std::vector<SphericalCoord> receivers;
+    for (int i = 0; i < 64; ++i) {
+        receivers.emplace_back(6.0, M_PI / 2.0, 2.0 * M_PI * i / 64.0, 0.0, 1.0 + 0.05 * i);
+    }
+    auto responses = generator.generate(source, receivers);
+    assert(responses.size() == 64);
+    for (size_t i = 0; i < responses.size(); i += 16) {
+        assert(responses[i].samples == generator.generate(source, receivers[i]).samples);
+    }
+    
+    // Disk cache: a second generator with the same inputs loads the file.
+    // A fresh directory keeps leftovers of earlier runs from turning the miss into a hit
+    namespace fs = std::filesystem;
+    fs::path cache_directory;
+    const auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+    for (int attempt = 0; cache_directory.empty(); ++attempt) {
+        fs::path candidate = fs::temp_directory_path() /
+                             ("anantasound_ir_cache_" + std::to_string(stamp) + "_" + std::to_string(attempt));
+        if (fs::create_directory(candidate)) {
+            cache_directory = candidate;
+        }
+    }
+    settings.cache_directory = cache_directory.string();
+    DomeImpulseResponseGenerator cached(resonator, settings);
+    ImpulseResponse stored = cached.generate(source, receiver);
+    assert(cached.getCacheMisses() == 1 && cached.getCacheHits() == 0);
+    DomeImpulseResponseGenerator reloaded(resonator, settings);
+    ImpulseResponse loaded = reloaded.generate(source, receiver);
+    assert(reloaded.getCacheHits() == 1);
+    assert(loaded.samples == stored.samples && loaded.samples == ir.samples);
+    
+    // Different material, different key
+    DomeAcousticResonator absorbent(8.0, 8.0);
+    absorbent.setShapeModel(DomeShapeModel::HEMISPHERE);
+    absorbent.setMaterial(AcousticMaterial::preset(MaterialPreset::ABSORBENT));
+    assert(DomeImpulseResponseGenerator(absorbent, settings).cacheKey(source, receiver) !=
+           cached.cacheKey(source, receiver));
+    fs::remove_all(cache_directory);
+    
+    std::cout << "✓ DomeImpulseResponseGenerator test passed" << std::endl;
+}
+
+void test_room_response_cache() {
+    std::cout << "Testing RoomResponseCache..." << std::endl;
+    
+    DomeAcousticResonator resonator(8.0, 8.0);
+    resonator.setShapeModel(DomeShapeModel::HEMISPHERE);
+    resonator.setMaterial(AcousticMaterial::preset(MaterialPreset::STANDARD));
+    auto cache = std::make_shared<RoomResponseCache>(resonator);
+    const double c = cache->getSpeedOfSound();
+    
+    // Grid pair 4 m apart, 1.5 m above the floor: floor image at 5 m and
+    // the specular point at the top of the shell, 2 * sqrt(2^2 + 6.5^2) m
+    SphericalCoord source(2.0, M_PI / 2.0, 0.0, 0.0, 1.5);
+    SphericalCoord receiver(2.0, M_PI / 2.0, M_PI, 0.0, 1.5);
+    RoomTransferPtr grid = cache->getGridTransfer(source, receiver);
+    assert(std::abs(grid->delay - 4.0 / c) < 1e-9);
+    assert(std::abs(grid->gain - 0.25) < 1e-9);
+    auto has_tap = [&](const RoomTransfer& transfer, double length) {
+        for (const ReflectionTap& tap : transfer.taps) {
+            if (std::abs(tap.delay * c - length) < 1e-3) return true;
+        }
+        return false;
+    };
+    assert(has_tap(*grid, 5.0));
+    assert(has_tap(*grid, 2.0 * std::sqrt(4.0 + 6.5 * 6.5)));
+    for (size_t i = 1; i < grid->taps.size(); ++i) {
+        assert(grid->taps[i].delay >= grid->taps[i - 1].delay);
+        assert(grid->taps[i].gain > 0.0 && grid->taps[i].gain < 1.0);
+    }
+    assert(cache->getMisses() == 1 && cache->getHits() == 0);
+    cache->getGridTransfer(source, receiver);
+    assert(cache->getHits() == 1 && cache->getEntryCount() == 1);
+    
+    // Off-grid source: trilinear blend of the 8 corners stays close to the exact taps
+    double s[3] = {1.13, 0.37, 1.62};
+    double r[3] = {-2.0, 0.0, 1.5};
+    RoomTransfer exact = cache->computeTransfer(s, r);
+    RoomTransfer blended;
+    cache->lookup(s, r, blended);
+    assert(std::abs(blended.delay - exact.delay) < 1e-12);
+    assert(blended.taps.size() == exact.taps.size());
+    for (size_t i = 0; i < exact.taps.size(); ++i) {
+        assert(std::abs(blended.taps[i].delay - exact.taps[i].delay) * c < 0.05);
+        assert(std::abs(blended.taps[i].gain - exact.taps[i].gain) < 0.1 * exact.taps[i].gain);
+    }
+    
+    // Corners are matched by reflection, not by position in delay order: each
+    // blended tap stays within a cell diagonal of an exact tap of its surface
+    for (int i = 0; i < 200; ++i) {
+        double p[3] = {-5.0 + 0.0537 * i, 3.0 * std::sin(0.71 * i), 0.2 + 0.031 * i};
+        cache->lookup(p, r, blended);
+        RoomTransfer reference = cache->computeTransfer(p, r);
+        for (size_t t = 0; t < blended.taps.size(); ++t) {
+            assert(t == 0 || blended.taps[t].delay >= blended.taps[t - 1].delay);
+            bool near_exact = false;
+            for (const ReflectionTap& tap : reference.taps) {
+                near_exact = near_exact || (tap.kind == blended.taps[t].kind &&
+                                            std::abs(tap.delay - blended.taps[t].delay) * c < std::sqrt(3.0) * 0.25);
+            }
+            assert(near_exact);
+        }
+    }
+    
+    // A slowly moving source reuses the same corners
+    size_t misses = cache->getMisses();
+    for (int step = 0; step < 20; ++step) {
+        s[0] += 0.005;
+        cache->lookup(s, r, blended);
+    }
+    assert(cache->getMisses() == misses);
+    
+    // Memory budget with LRU eviction
+    RoomResponseCacheSettings small;
+    small.memory_budget = 32 * 1024;
+    RoomResponseCache bounded(resonator, small);
+    for (int i = 0; i < 2000; ++i) {
+        double p[3] = {-6.0 + 0.25 * (i % 48), -3.0 + 0.25 * (i / 48 % 24), 1.0};
+        RoomTransfer transfer;
+        bounded.lookup(p, r, transfer);
+    }
+    assert(bounded.getEvictions() > 0);
+    assert(bounded.getMemoryUsage() <= small.memory_budget + 16 * 1024);
+    bounded.clear();
+    assert(bounded.getEntryCount() == 0 && bounded.getMemoryUsage() == 0);
+    
+    // Shared by two fields: each source adds its taps relative to the direct path
+    InterferenceField first(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 8.0);
+    InterferenceField second(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 8.0);
+    QuantumSoundField field;
+    field.amplitude = std::complex<double>(1.0, 0.0);
+    field.frequency = 200.0;
+    field.quantum_state = QuantumSoundState::COHERENT;
+    field.position = source;
+    first.addSourceField(field);
+    second.addSourceField(field);
+    std::complex<double> dry = first.calculateInterference(receiver, 0.0);
+    first.setRoomResponseCache(cache);
+    second.setRoomResponseCache(cache);
+    assert(first.getRoomResponseCache() == second.getRoomResponseCache());
+    std::complex<double> wet = first.calculateInterference(receiver, 0.0);
+    assert(std::abs(wet - second.calculateInterference(receiver, 0.0)) < 1e-12);
+    
+    // A receiver that stays put is evaluated again from its stored taps
+    const size_t point_lookups = cache->getHits() + cache->getMisses();
+    assert(first.calculateInterference(receiver, 0.5) == first.calculateInterference(receiver, 0.5));
+    assert(cache->getHits() + cache->getMisses() == point_lookups);
+    
+    RoomTransfer transfer = cache->lookup(source, receiver);
+    double k = 2.0 * M_PI * field.frequency / kSpeedOfSound;
+    std::complex<double> reflections(0.0, 0.0);
+    for (const ReflectionTap& tap : transfer.taps) {
+        reflections += (tap.gain / transfer.gain) * std::exp(std::complex<double>(0.0, -k * c * tap.delay));
+    }
+    std::complex<double> gain = field.amplitude * getQuantumStateFactor(field.quantum_state);
+    assert(std::abs(wet - dry - gain * reflections) < 1e-6 * std::abs(gain));
+    
+    auto batch = first.calculateInterferenceBatch({receiver, source}, 0.0);
+    assert(std::abs(batch[0] - wet) < 1e-12);
+    
+    // Batches keep the taps of every pair: a static scene is evaluated again
+    // without touching the shared cache, and a moved source re-queries only its row
+    InterferenceField scene(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 8.0);
+    std::vector<SphericalCoord> speakers;
+    for (int i = 0; i < 32; ++i) {
+        speakers.emplace_back(7.0, M_PI / 2.0, 2.0 * M_PI * i / 32.0, 0.0, 1.0 + 0.5 * (i % 4));
+    }
+    std::vector<InterferenceField::SourceId> ids;
+    for (int i = 0; i < 48; ++i) {
+        field.position = SphericalCoord(0.5 + 0.1 * i, M_PI / 2.0, 0.37 * i, 0.0, 1.0 + 0.08 * i);
+        ids.push_back(scene.addSourceField(field));
+    }
+    auto scene_cache = std::make_shared<RoomResponseCache>(resonator);
+    scene.setRoomResponseCache(scene_cache);
+    auto cold = scene.calculateInterferenceBatch(speakers, 0.0);
+    const size_t lookups = scene_cache->getHits() + scene_cache->getMisses();
+    assert(scene_cache->getMisses() == scene_cache->getEntryCount() && scene_cache->getEvictions() == 0);
+    
+    auto warm = scene.calculateInterferenceBatch(speakers, 0.0);
+    assert(scene_cache->getHits() + scene_cache->getMisses() == lookups);
+    assert(warm == cold);
+    
+    field.position = SphericalCoord(2.0, M_PI / 2.0, 1.0, 0.0, 2.0);
+    scene.removeSourceField(ids[5]);
+    scene.addSourceField(field);
+    auto moved = scene.calculateInterferenceBatch(speakers, 0.0);
+    assert(scene_cache->getHits() + scene_cache->getMisses() <= lookups + 2 * 8 * speakers.size());
+    for (size_t i = 0; i < speakers.size(); ++i) {
+        std::complex<double> single = scene.calculateInterference(speakers[i], 0.0);
+        assert(std::abs(moved[i] - single) < 1e-9 * std::abs(single));
+    }
+    // Stored taps count against the cache budget and are returned with the field
+    assert(scene_cache->getReservedMemory() > 0);
+    assert(scene_cache->getMemoryUsage() <= scene_cache->getSettings().memory_budget);
+    RoomResponseCacheSettings tight;
+    tight.memory_budget = 16 * 1024;
+    auto tight_cache = std::make_shared<RoomResponseCache>(resonator, tight);
+    {
+        InterferenceField crowded(InterferenceFieldType::CONSTRUCTIVE, SphericalCoord(), 8.0);
+        crowded.addSourceField(field);
+        crowded.setRoomResponseCache(tight_cache);
+        auto small_batch = crowded.calculateInterferenceBatch({receiver}, 0.0);
+        assert(tight_cache->getReservedMemory() > 0);
+        
+        // Too many taps for the budget: evaluated, then dropped
+        for (int i = 0; i < 48; ++i) {
+            field.position = SphericalCoord(0.5 + 0.1 * i, M_PI / 2.0, 0.37 * i, 0.0, 1.0 + 0.08 * i);
+            crowded.addSourceField(field);
+        }
+        auto large_batch = crowded.calculateInterferenceBatch(speakers, 0.0);
+        assert(tight_cache->getReservedMemory() <= tight.memory_budget / 2);
+        for (size_t i = 0; i < speakers.size(); i += 7) {
+            std::complex<double> single = crowded.calculateInterference(speakers[i], 0.0);
+            assert(std::abs(large_batch[i] - single) < 1e-9 * std::abs(single));
+        }
+    }
+    assert(tight_cache->getReservedMemory() == 0);
+    
+    std::cout << "✓ RoomResponseCache test passed" << std::endl;
+}
@@ -14,8 +14,28 @@ void test_quantum_resonance_device();
 void test_mechanical_device_manager();
 void test_quantum_sound_field();
 void test_interference_field();
+void test_interference_field_source_store();
+void test_interference_field_batch();
+void test_spatial_field_store();
 void test_dome_acoustic_resonator();
+void test_dome_modal_solver();
+void test_acoustic_material();
+void test_room_eq();
+void test_dome_impulse_response();
+void test_room_response_cache();
 void test_anantasound_core();
+void test_anantasound_core_bulk_ingest();
+void test_anantasound_core_snapshot();
+void test_anantasound_core_parallel_update();
+void test_anantasound_core_fixed_timestep();
+void test_entanglement_graph();
+void test_slot_map();
+void test_interference_source_tree();
+void test_quantum_acoustic_processor();
+void test_fast_sincos();
+void test_phasor_rotator();
+void test_random_stream();
+void test_multichannel_renderer();
 
 int main() {
     std::cout << "Running anAntaSound Tests..." << std::endl;
@@ -45,8 +65,34 @@ int main() {
         std::cout << "\n--- Core System Tests ---" << std::endl;
         test_quantum_sound_field();
         test_interference_field();
+        test_interference_field_source_store();
+        test_interference_field_batch();
+        test_spatial_field_store();
         test_dome_acoustic_resonator();
+        test_dome_modal_solver();
+        test_acoustic_material();
+        test_room_eq();
+        test_dome_impulse_response();
+        test_room_response_cache();
         test_anantasound_core();
+        test_anantasound_core_bulk_ingest();
+        test_anantasound_core_snapshot();
+        test_anantasound_core_parallel_update();
+        test_anantasound_core_fixed_timestep();
+        test_entanglement_graph();
+        test_slot_map();
+        test_interference_source_tree();
+        test_quantum_acoustic_processor();
+        
+        // Math kernel tests
+        std::cout << "\n--- Math Kernel Tests ---" << std::endl;
+        test_fast_sincos();
+        test_phasor_rotator();
+        test_random_stream();
+        
+        // Rendering tests
+        std::cout << "\n--- Rendering Tests ---" << std::endl;
+        test_multichannel_renderer();
         
         std::cout << "\n================================" << std::endl;
         std::cout << "✓ All tests passed successfully!" << std::endl;
@@ -90,6 +90,50 @@ void test_mechanical_device_manager() {
     
     manager.synchronizeDevices();
     
+    // Appending into a per-frame arena matches the vector variant and stops
+    // allocating once the arena has grown to the frame's size
+    FieldArena arena;
+    const QuantumSoundField* storage = nullptr;
+    for (int frame = 0; frame < 3; ++frame) {
+        arena.reset();
+        FieldRange range = manager.generateAllDeviceFields(arena);
+        size_t karmic_count = cluster->generateKarmicFields(arena.buffer());
+        assert(range.offset == 0 && range.count == all_fields.size());
+        assert(karmic_count == cluster->generateKarmicFields().size());
+        assert(arena.size() == all_fields.size() + karmic_count);
+        for (size_t i = 0; i < range.count; ++i) {
+            const QuantumSoundField& field = arena.begin(range)[i];
+            assert(field.frequency == all_fields[i].frequency);
+            assert(field.amplitude == all_fields[i].amplitude);
+            assert(field.phase == all_fields[i].phase);
+        }
+        if (frame > 0) {
+            assert(arena.begin(range) == storage);
+        }
+        storage = arena.begin(range);
+    }
+    assert(arena.getPeakSize() == all_fields.size() + cluster->generateKarmicFields().size());
+    
+    // Handles survive removal of other devices
+    auto resonance = std::make_shared<KarmicCluster>(position, 2);
+    auto handle = manager.addDevice(resonance);
+    manager.removeDevice(size_t(0));
+    assert(manager.getDevice(handle) == resonance);
+    assert(manager.removeDevice(handle));
+    assert(!manager.removeDevice(handle));
+    assert(manager.getDevice(handle) == nullptr);
+    assert(manager.getDeviceCount() == 1);
+    
+    // Removal by index keeps the order of the remaining devices
+    auto second = std::make_shared<KarmicCluster>(position, 2);
+    auto third = std::make_shared<KarmicCluster>(position, 3);
+    manager.addDevice(second);
+    manager.addDevice(third);
+    auto remaining = manager.getDevice(size_t(0));
+    manager.removeDevice(size_t(1));
+    assert(manager.getDevice(size_t(0)) == remaining);
+    assert(manager.getDevice(size_t(1)) == third);
+    
     std::cout << "✓ MechanicalDeviceManager test passed" << std::endl;
 }
 
@@ -21,6 +21,77 @@ void test_quantum_feedback_system() {
     assert(std::abs(feedback.getFeedbackGain() - 2.0) < 1e-6);
     assert(std::abs(feedback.getQuantumThreshold() - 0.8) < 1e-6);
     
+    // Batch kernel matches processFeedback input by input
+    feedback.setQuantumThreshold(0.6);
+    RandomStream random(42, 0);
+    auto make_fields = [&random](size_t count) {
+        std::vector<QuantumSoundField> fields(count);
+        for (auto& field : fields) {
+            field.amplitude = std::complex<double>(random.nextUniform() - 0.5, random.nextUniform() - 0.5);
+            field.frequency = 100.0 + 1900.0 * random.nextUniform();
+            field.phase = 2.0 * M_PI * random.nextUniform() - M_PI;
+            field.quantum_state = static_cast<QuantumSoundState>(static_cast<int>(6.0 * random.nextUniform()) % 6);
+        }
+        return fields;
+    };
+    std::vector<QuantumSoundField> inputs = make_fields(97);
+    std::vector<QuantumSoundField> feedback_fields = make_fields(131);
+    std::vector<QuantumSoundField> batch = feedback.processFeedbackBatch(inputs, feedback_fields);
+    assert(batch.size() == inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        QuantumSoundField single = feedback.processFeedback(inputs[i], feedback_fields);
+        assert(std::abs(batch[i].amplitude - single.amplitude) < 1e-9);
+        assert(batch[i].quantum_state == single.quantum_state);
+    }
+    
+    // Above a 2/3 threshold far pairs are culled by the frequency index without changing the result
+    feedback.setQuantumThreshold(0.75);
+    batch = feedback.processFeedbackBatch(inputs, feedback_fields);
+    assert(feedback.getLastFeedbackErrorBound() == 0.0);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        QuantumSoundField single = feedback.processFeedback(inputs[i], feedback_fields);
+        assert(std::abs(batch[i].amplitude - single.amplitude) < 1e-9);
+        assert(batch[i].quantum_state == single.quantum_state);
+    }
+    
+    // A narrower bandwidth stays within the reported bound
+    feedback.setQuantumThreshold(0.6);
+    feedback.setCorrelationBandwidth(300.0);
+    batch = feedback.processFeedbackBatch(inputs, feedback_fields);
+    double bound = feedback.getLastFeedbackErrorBound();
+    assert(bound > 0.0);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        QuantumSoundField single = feedback.processFeedback(inputs[i], feedback_fields);
+        assert(std::abs(batch[i].amplitude - single.amplitude) <= bound + 1e-9);
+    }
+    feedback.setCorrelationBandwidth(0.0);
+    
+    FrequencyIndex index;
+    const double frequencies[] = {440.0, 100.0, 1000.0, 432.0, 445.0};
+    index.build(frequencies, 5);
+    auto band = index.range(440.0, 8.0);
+    assert(band.second - band.first == 3 && index.order()[band.first] == 3);
+    assert(index.weightOutside(band.first, band.second) == 2.0);
+    
+    feedback.setQuantumMode(false);
+    batch = feedback.processFeedbackBatch(inputs, feedback_fields);
+    assert(std::abs(batch[5].amplitude - feedback.processFeedback(inputs[5], feedback_fields).amplitude) < 1e-9);
+    feedback.setQuantumMode(true);
+    
+    // 1k x 1k on the thread pool: the culled batch still matches processFeedback
+    inputs = make_fields(1000);
+    feedback_fields = make_fields(1000);
+    feedback.setQuantumThreshold(0.9);
+    batch = feedback.processFeedbackBatch(inputs, feedback_fields);
+    assert(batch.size() == inputs.size());
+    bound = feedback.getLastFeedbackErrorBound();
+    assert(bound == 0.0);
+    for (size_t i = 0; i < inputs.size(); i += 37) {
+        QuantumSoundField single = feedback.processFeedback(inputs[i], feedback_fields);
+        assert(std::abs(batch[i].amplitude - single.amplitude) <= bound + 1e-9);
+        assert(batch[i].quantum_state == single.quantum_state);
+    }
+    
     std::cout << "✓ QuantumFeedbackSystem test passed" << std::endl;
 }
 
@@ -38,6 +109,63 @@ void test_quantum_resonance_detector() {
     bool detected = detector.detectResonance(field);
     assert(detected);
     
+    // Streaming: a watched tone and an unwatched one in light noise
+    const double sample_rate = 48000.0;
+    detector.configureStream(sample_rate, 4096);
+    detector.setWatchedFrequencies({500.0, 1000.0, 1500.0, 2000.0});
+    assert(detector.getWatchedFrequencies().size() == 4 && !detector.isStreamReady());
+    
+    RandomStream noise(7, 0);
+    std::vector<float> block(256);
+    size_t sample_index = 0;
+    auto next_block = [&]() {
+        for (float& sample : block) {
+            double t = sample_index++ / sample_rate;
+            sample = static_cast<float>(0.5 * std::sin(2.0 * M_PI * 1003.0 * t) +
+                                         0.2 * std::sin(2.0 * M_PI * 3210.0 * t) + 1e-3 * noise.nextNormal());
+        }
+    };
+    for (int b = 0; b < 40; ++b) {
+        next_block();
+        detector.processAudio(block.data(), block.size());
+    }
+    assert(detector.isStreamReady());
+    
+    std::vector<ResonancePeak> peaks = detector.getWatchedPeaks();
+    assert(peaks.size() == 1 && peaks[0].watched);
+    assert(std::abs(peaks[0].frequency - 1003.0) < 1.0);
+    assert(std::abs(peaks[0].amplitude - 0.5) < 0.025);
+    
+    // A pure tone is resolution-limited: Q ~ f N / (1.44 fs)
+    double resolution_q = 1003.0 * 4096.0 / (1.44 * sample_rate);
+    assert(peaks[0].q > 0.75 * resolution_q && peaks[0].q < 1.25 * resolution_q);
+    
+    // Broad STFT search finds the unwatched tone as well
+    std::vector<ResonancePeak> found = detector.searchResonantPeaks(2);
+    assert(found.size() == 2 && !found[0].watched);
+    assert(std::abs(found[0].frequency - 1003.0) < 2.0);
+    assert(std::abs(found[1].frequency - 3210.0) < 2.0);
+    assert(std::abs(found[1].amplitude - 0.2) < 0.02);
+    
+    // 50 watched frequencies: only the bin on the 1003 Hz tone reports a peak
+    std::vector<double> watched;
+    for (int i = 0; i < 49; ++i) {
+        watched.push_back(100.0 + 37.0 * i);
+    }
+    watched.push_back(1003.0);
+    detector.setWatchedFrequencies(watched);
+    for (int b = 0; b < 188; ++b) {
+        next_block();
+        detector.processAudio(block.data(), block.size());
+    }
+    peaks = detector.getWatchedPeaks();
+    assert(peaks.size() == 1 && peaks[0].watched);
+    assert(std::abs(peaks[0].frequency - 1003.0) < 1.0);
+    assert(std::abs(peaks[0].amplitude - 0.5) < 0.025);
+    
+    detector.resetStream();
+    assert(!detector.isStreamReady() && detector.getWatchedPeaks().empty());
+    
     std::cout << "✓ QuantumResonanceDetector test passed" << std::endl;
 }
 
@@ -59,6 +187,94 @@ void test_quantum_phase_synchronizer() {
     auto synchronized = sync.synchronizePhases(fields);
     assert(synchronized.size() == fields.size());
     
+    // Reference is the circular mean: coherent phases on both sides of ±π give π, not 0
+    fields[0].phase = M_PI - 0.1;
+    fields[1].phase = -M_PI + 0.1;
+    fields[2].phase = 0.0;
+    fields[2].quantum_state = QuantumSoundState::SUPERPOSITION;
+    sync.synchronizePhasesInPlace(fields);
+    assert(std::abs(std::abs(fields[2].phase) - M_PI) < 1e-9);
+    assert(fields[2].quantum_state == QuantumSoundState::COHERENT);
+    
+    // Continuous mode: phases spread across the wrap converge without jumps
+    const double dt = 1.0 / 60.0;
+    std::vector<QuantumPhaseSynchronizer::ChannelId> channels;
+    for (int i = 0; i < 64; ++i) {
+        QuantumSoundField field;
+        field.amplitude = std::complex<double>(1.0, 0.0);
+        field.frequency = 432.0;
+        field.phase = M_PI + 0.6 * std::sin(i * 1.7);
+        field.quantum_state = i % 4 == 0 ? QuantumSoundState::SUPERPOSITION : QuantumSoundState::COHERENT;
+        channels.push_back(sync.attachField(field));
+    }
+    assert(sync.getChannelCount() == channels.size());
+    
+    std::vector<double> previous(channels.size());
+    for (size_t i = 0; i < channels.size(); ++i) {
+        QuantumSoundField output;
+        assert(sync.getSynchronizedField(channels[i], output));
+        previous[i] = output.phase;
+    }
+    
+    double max_step = 0.0;
+    for (int frame = 0; frame < 240 && sync.getActiveChannelCount() > 0; ++frame) {
+        sync.tick(dt);
+        for (auto id : sync.getChangedChannels()) {
+            size_t i = id.index;
+            QuantumSoundField output;
+            sync.getSynchronizedField(id, output);
+            double step = std::remainder(output.phase - previous[i], 2.0 * M_PI);
+            max_step = std::max(max_step, std::abs(step));
+            previous[i] = output.phase;
+        }
+    }
+    assert(std::abs(std::remainder(sync.getReferencePhase() - M_PI, 2.0 * M_PI)) < 0.2);
+    assert(max_step < 0.25);
+    for (size_t i = 0; i < channels.size(); ++i) {
+        assert(sync.isLocked(channels[i]));
+        QuantumSoundField output;
+        sync.getSynchronizedField(channels[i], output);
+        assert(std::abs(std::remainder(output.phase - sync.getReferencePhase(), 2.0 * M_PI)) < 0.02);
+        assert(output.quantum_state == QuantumSoundState::COHERENT);
+    }
+    
+    // Locked channels cost nothing; a small update touches only that channel
+    assert(sync.tick(dt) == 0);
+    QuantumSoundField moved;
+    sync.getSynchronizedField(channels[5], moved);
+    moved.phase += 0.05;
+    sync.updateField(channels[5], moved);
+    assert(sync.tick(dt) == 1);
+    
+    assert(sync.detachField(channels[5]));
+    assert(!sync.detachField(channels[5]));
+    assert(sync.getChannelCount() == channels.size() - 1);
+    
+    // Attach, detach and reattach past the exact-recompute interval: the
+    // reference follows the channels that are actually attached
+    QuantumPhaseSynchronizer churn(M_PI / 8.0);
+    std::vector<QuantumPhaseSynchronizer::ChannelId> attached;
+    QuantumSoundField coherent;
+    coherent.amplitude = std::complex<double>(1.0, 0.0);
+    coherent.frequency = 432.0;
+    coherent.phase = 0.0;
+    coherent.quantum_state = QuantumSoundState::COHERENT;
+    for (int i = 0; i < 4095; ++i) {
+        attached.push_back(churn.attachField(coherent));
+    }
+    for (auto id : attached) {
+        assert(churn.detachField(id));
+    }
+    coherent.phase = 2.0;
+    auto survivor = churn.attachField(coherent);
+    churn.tick(dt);
+    assert(churn.getChannelCount() == 1);
+    assert(std::abs(churn.getReferencePhase() - 2.0) < 1e-9);
+    coherent.phase = -1.0;
+    assert(churn.updateField(survivor, coherent));
+    churn.tick(dt);
+    assert(std::abs(churn.getReferencePhase() + 1.0) < 1e-9);
+    
     std::cout << "✓ QuantumPhaseSynchronizer test passed" << std::endl;
 }
 
@@ -0,0 +1,66 @@
+#include "quantum_random.hpp"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <thread>
+
+using namespace AnantaSound;
+
+void test_random_stream() {
+    std::cout << "Testing RandomStream..." << std::endl;
+    
+    // Known-answer vector for Philox4x32-10 (Random123)
+    PhiloxCounter zero = philox4x32({0, 0, 0, 0}, {0, 0});
+    assert(zero[0] == 0x6627e8d5u && zero[1] == 0xe169c58du);
+    assert(zero[2] == 0xbc57ac4cu && zero[3] == 0x9b00dbd8u);
+    
+    // Same seed and stream give the same sequence; the batch path matches
+    // the stateless per-index function
+    RandomStream a(1234, 5), b(1234, 5);
+    std::vector<double> batch(1001);
+    a.fillUniform(batch.data(), batch.size());
+    for (size_t i = 0; i < batch.size(); i += 2) {
+        assert(batch[i] == philoxUniform(1234, 5, i / 2));
+        assert(batch[i] >= 0.0 && batch[i] < 1.0);
+    }
+    std::vector<double> repeat(1001);
+    b.fillUniform(repeat.data(), repeat.size());
+    assert(batch == repeat);
+    assert(a.nextUniform() == b.nextUniform());
+    
+    // Normal batches have the requested moments
+    RandomStream normal_stream(99);
+    std::vector<double> normals(200001);
+    normal_stream.fillNormal(normals.data(), normals.size(), 2.0, 0.5);
+    double mean = 0.0, variance = 0.0;
+    for (double v : normals) mean += v;
+    mean /= normals.size();
+    for (double v : normals) variance += (v - mean) * (v - mean);
+    variance /= normals.size();
+    assert(std::abs(mean - 2.0) < 0.01);
+    assert(std::abs(std::sqrt(variance) - 0.5) < 0.01);
+    
+    double scalar_sum = 0.0;
+    for (int i = 0; i < 20000; ++i) scalar_sum += normal_stream.nextNormal();
+    assert(std::abs(scalar_sum / 20000.0) < 0.05);
+    
+    // A fixed global seed makes instance streams reproducible
+    const uint64_t previous_seed = getGlobalRandomSeed();
+    setGlobalRandomSeed(77);
+    RandomStream first;
+    setGlobalRandomSeed(77);
+    RandomStream second;
+    assert(first.getSeed() == second.getSeed());
+    RandomStream third;
+    assert(third.getSeed() != second.getSeed());
+    setGlobalRandomSeed(previous_seed);
+    
+    // Thread-local streams are distinct per thread
+    uint64_t main_seed = RandomStream::threadLocal().getSeed();
+    uint64_t other_seed = 0;
+    std::thread([&other_seed]() { other_seed = RandomStream::threadLocal().getSeed(); }).join();
+    assert(main_seed != other_seed);
+    
+    std::cout << "✓ RandomStream test passed" << std::endl;
+}